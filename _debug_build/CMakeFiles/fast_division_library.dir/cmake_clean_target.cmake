@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libfast_division_library.a"
+)
@@ -0,0 +1,20 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/benchmarks/benchmark_harness.cpp" "benchmarks/CMakeFiles/fast_division_benchmarks.dir/benchmark_harness.cpp.o" "gcc" "benchmarks/CMakeFiles/fast_division_benchmarks.dir/benchmark_harness.cpp.o.d"
+  "/root/repo/benchmarks/fast_division_benchmarks.cpp" "benchmarks/CMakeFiles/fast_division_benchmarks.dir/fast_division_benchmarks.cpp.o" "gcc" "benchmarks/CMakeFiles/fast_division_benchmarks.dir/fast_division_benchmarks.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
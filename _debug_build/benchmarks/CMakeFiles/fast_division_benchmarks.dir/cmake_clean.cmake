@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/fast_division_benchmarks.dir/benchmark_harness.cpp.o"
+  "CMakeFiles/fast_division_benchmarks.dir/benchmark_harness.cpp.o.d"
+  "CMakeFiles/fast_division_benchmarks.dir/fast_division_benchmarks.cpp.o"
+  "CMakeFiles/fast_division_benchmarks.dir/fast_division_benchmarks.cpp.o.d"
+  "fast_division_benchmarks"
+  "fast_division_benchmarks.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/fast_division_benchmarks.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
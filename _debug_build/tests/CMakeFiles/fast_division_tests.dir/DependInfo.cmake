@@ -0,0 +1,20 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tests/fast_division_tests.cpp" "tests/CMakeFiles/fast_division_tests.dir/fast_division_tests.cpp.o" "gcc" "tests/CMakeFiles/fast_division_tests.dir/fast_division_tests.cpp.o.d"
+  "/root/repo/tests/test_harness.cpp" "tests/CMakeFiles/fast_division_tests.dir/test_harness.cpp.o" "gcc" "tests/CMakeFiles/fast_division_tests.dir/test_harness.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
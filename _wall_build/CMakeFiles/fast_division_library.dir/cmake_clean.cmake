@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "libfast_division_library.a"
+  "libfast_division_library.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/fast_division_library.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/fast_division_example.dir/fast_division_example.cpp.o"
+  "CMakeFiles/fast_division_example.dir/fast_division_example.cpp.o.d"
+  "fast_division_example"
+  "fast_division_example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/fast_division_example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/fast_division_baseline_tests.dir/baseline_target_tests.cpp.o"
+  "CMakeFiles/fast_division_baseline_tests.dir/baseline_target_tests.cpp.o.d"
+  "fast_division_baseline_tests"
+  "fast_division_baseline_tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/fast_division_baseline_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
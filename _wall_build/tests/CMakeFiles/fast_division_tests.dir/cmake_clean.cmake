@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/fast_division_tests.dir/fast_division_tests.cpp.o"
+  "CMakeFiles/fast_division_tests.dir/fast_division_tests.cpp.o.d"
+  "CMakeFiles/fast_division_tests.dir/test_harness.cpp.o"
+  "CMakeFiles/fast_division_tests.dir/test_harness.cpp.o.d"
+  "fast_division_tests"
+  "fast_division_tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/fast_division_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
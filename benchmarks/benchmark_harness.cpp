@@ -0,0 +1,67 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "fast_division_benchmarks.hpp"
+
+namespace fd_b = fast_division::benchmarks;
+
+namespace {
+
+    void usage(const char* program)
+    {
+        std::cerr << "Usage: " << program << " [--min-time seconds] [--filter substring] [--output file]\n"
+                  << "Results are written as JSON, to standard output unless a file is given.\n";
+    }
+
+}
+
+int main(int argc, char* argv[])
+{
+    double min_seconds = 0.1;
+    std::string filter;
+    std::string output;
+    for (int i = 1; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--min-time") == 0 && has_value) {
+            min_seconds = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--filter") == 0 && has_value) {
+            filter = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--output") == 0 && has_value) {
+            output = argv[++i];
+        }
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    fd_b::benchmark_context context(min_seconds, filter);
+    fd_b::division_throughput(context);
+    fd_b::division_latency(context);
+    fd_b::divider_construction(context);
+    fd_b::parallel_scaling(context);
+    fd_b::integer_formatting(context);
+    fd_b::hash_table_lookup(context);
+    fd_b::divider_footprint(context);
+    fd_b::double_word_division(context);
+    fd_b::limb_division(context);
+    fd_b::modular_arithmetic(context);
+    fd_b::mixed_radix(context);
+
+    if (output.empty()) {
+        context.write_json(std::cout);
+    }
+    else {
+        std::ofstream file(output);
+        if (!file) {
+            std::cerr << "Cannot open " << output << '\n';
+            return 1;
+        }
+        context.write_json(file);
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fast_division/fast_division_dispatch.hpp>
+
+namespace fast_division {
+
+    namespace benchmarks {
+
+        /// Keep the compiler from optimizing a value away or computing it at compile time.
+
+        template <typename T>
+        inline void do_not_optimize(T const& value)
+        {
+        #if defined(__GNUC__)
+            asm volatile("" : : "m"(value) : "memory");
+        #else
+            static volatile char sink;
+            sink = *reinterpret_cast<volatile const char*>(&value);
+        #endif
+        }
+
+        template <typename T>
+        inline T opaque(T value)
+        {
+        #if defined(__GNUC__)
+            asm volatile("" : "+m"(value));
+            return value;
+        #else
+            volatile T copy = value;
+            return copy;
+        #endif
+        }
+
+        using labels = std::vector<std::pair<std::string, std::string>>;
+
+        struct benchmark_result {
+            std::string name;
+            labels properties;
+            double ns_per_op;
+            uint64_t operations;
+        };
+
+        /// Runs benchmarks, collects their results and writes them as JSON.
+        class benchmark_context {
+        public:
+            benchmark_context(double min_seconds, std::string filter)
+                : min_seconds_(min_seconds), filter_(std::move(filter))
+            {}
+
+            /// Call body repeatedly for at least the minimum time. Every call performs
+            /// operations_per_call operations. The best of three such runs is kept.
+            template <typename Body>
+            void run(const std::string& name, labels properties, uint64_t operations_per_call, Body&& body)
+            {
+                if (!filter_.empty() && name.find(filter_) == std::string::npos) {
+                    return;
+                }
+                using clock = std::chrono::steady_clock;
+                // Warm up caches and the branch predictors.
+                body();
+                double best = 0.0;
+                uint64_t total_operations = 0;
+                for (int repetition = 0; repetition != 3; ++repetition) {
+                    uint64_t calls = 0;
+                    auto start = clock::now();
+                    std::chrono::duration<double> elapsed(0);
+                    do {
+                        for (int i = 0; i != 16; ++i) {
+                            body();
+                        }
+                        calls += 16;
+                        elapsed = clock::now() - start;
+                    } while (elapsed.count() < min_seconds_ / 3);
+                    double ns = elapsed.count() * 1e9 / double(calls * operations_per_call);
+                    if (repetition == 0 || ns < best) {
+                        best = ns;
+                    }
+                    total_operations += calls * operations_per_call;
+                }
+                results_.push_back({ name, std::move(properties), best, total_operations });
+            }
+
+            const std::vector<benchmark_result>& results() const { return results_; }
+
+            void write_json(std::ostream& out) const
+            {
+                out << "{\n  \"context\": {\n";
+                out << "    \"simd_level\": \"" << level_name(detected_simd_level()) << "\",\n";
+                out << "    \"compiler\": \"" << compiler_name() << "\",\n";
+                out << "    \"min_seconds\": " << min_seconds_ << "\n  },\n";
+                out << "  \"benchmarks\": [";
+                for (std::size_t i = 0; i != results_.size(); ++i) {
+                    auto& result = results_[i];
+                    out << (i ? ",\n" : "\n") << "    { \"name\": \"" << result.name << "\"";
+                    for (auto& property : result.properties) {
+                        out << ", \"" << property.first << "\": \"" << property.second << "\"";
+                    }
+                    out << ", \"ns_per_op\": " << result.ns_per_op
+                        << ", \"operations\": " << result.operations << " }";
+                }
+                out << "\n  ]\n}\n";
+            }
+
+            static const char* level_name(simd_level level)
+            {
+                switch (level) {
+                case simd_level::avx512: return "avx512";
+                case simd_level::avx2: return "avx2";
+                case simd_level::sse41: return "sse41";
+                default: return "scalar";
+                }
+            }
+
+        private:
+            static std::string compiler_name()
+            {
+            #if defined(__clang__)
+                return "clang " __clang_version__;
+            #elif defined(__GNUC__)
+                return "gcc " __VERSION__;
+            #elif defined(_MSC_VER)
+                return "msvc " + std::to_string(_MSC_VER);
+            #else
+                return "unknown";
+            #endif
+            }
+
+            double min_seconds_;
+            std::string filter_;
+            std::vector<benchmark_result> results_;
+        };
+
+    }
+
+}
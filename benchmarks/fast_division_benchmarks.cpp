@@ -0,0 +1,1057 @@
+#include "fast_division_benchmarks.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <immintrin.h>
+
+#include <fast_division/fast_division.hpp>
+#include <fast_division/branchfree_divider.hpp>
+#include <fast_division/parallel_division.hpp>
+#include <fast_division/integer_format.hpp>
+#include <fast_division/hash_buckets.hpp>
+#include <fast_division/divider_batch.hpp>
+#include <fast_division/packed_divider.hpp>
+#include <fast_division/double_word_divider.hpp>
+#include <fast_division/limb_division.hpp>
+#include <fast_division/modular_arithmetic.hpp>
+#include <fast_division/mixed_radix.hpp>
+#include <fast_division/division_policy.hpp>
+
+namespace fd_b = fast_division::benchmarks;
+
+using fast_division::constant_divider;
+using fast_division::constant_divider_base;
+using fast_division::simd_level;
+
+namespace {
+
+    constexpr std::size_t array_size = 4096;
+    constexpr std::size_t chain_length = 1024;
+    constexpr std::size_t parallel_array_size = std::size_t(1) << 24;
+    constexpr std::size_t hash_map_size = std::size_t(1) << 14;
+    constexpr std::size_t bignum_limbs = 1024;
+    constexpr std::size_t bignum_count = 16;
+
+    enum class divisor_class { one, power_of_two, small_odd, large };
+
+    const divisor_class divisor_classes[] = {
+        divisor_class::one, divisor_class::power_of_two, divisor_class::small_odd, divisor_class::large
+    };
+
+    const char* class_name(divisor_class c)
+    {
+        switch (c) {
+        case divisor_class::one: return "one";
+        case divisor_class::power_of_two: return "power_of_two";
+        case divisor_class::small_odd: return "small_odd";
+        default: return "large";
+        }
+    }
+
+    template <typename Integer> const char* type_name();
+    template <> const char* type_name<uint8_t>() { return "uint8_t"; }
+    template <> const char* type_name<int8_t>() { return "int8_t"; }
+    template <> const char* type_name<uint16_t>() { return "uint16_t"; }
+    template <> const char* type_name<int16_t>() { return "int16_t"; }
+    template <> const char* type_name<uint32_t>() { return "uint32_t"; }
+    template <> const char* type_name<int32_t>() { return "int32_t"; }
+    template <> const char* type_name<uint64_t>() { return "uint64_t"; }
+    template <> const char* type_name<int64_t>() { return "int64_t"; }
+
+    template <template <typename, bool> class DivisionPolicy> const char* policy_name();
+    template <> const char* policy_name<fast_division::promotion_policy>() { return "promotion"; }
+    template <> const char* policy_name<fast_division::decomposition_policy>() { return "decomposition"; }
+    template <> const char* policy_name<fast_division::fastmod_policy>() { return "fastmod"; }
+
+    /// A representative divisor of the class. Large divisors have the top usable bit set,
+    /// which gives the longest multipliers.
+    template <typename Integer>
+    Integer class_divisor(divisor_class c)
+    {
+        switch (c) {
+        case divisor_class::one: return Integer(1);
+        case divisor_class::power_of_two: return Integer(64);
+        case divisor_class::small_odd: return Integer(7);
+        default: return Integer(std::numeric_limits<Integer>::max() / 3 * 2 + 1);
+        }
+    }
+
+    /// Many distinct divisors of the class, for construction cost.
+    template <typename Integer>
+    std::vector<Integer> class_divisors(divisor_class c, std::size_t count)
+    {
+        std::mt19937_64 engine(42);
+        std::vector<Integer> divisors(count);
+        constexpr unsigned max_shift = 8 * sizeof(Integer) - (std::is_signed<Integer>::value ? 2 : 1);
+        for (auto& d : divisors) {
+            switch (c) {
+            case divisor_class::one:
+                d = Integer(1);
+                break;
+            case divisor_class::power_of_two:
+                d = Integer(Integer(1) << (1 + engine() % max_shift));
+                break;
+            case divisor_class::small_odd:
+                d = Integer(3 + 2 * (engine() % 1000));
+                break;
+            default:
+                d = Integer(std::numeric_limits<Integer>::max() / 2 + Integer(engine() % 1000000));
+                break;
+            }
+            if (std::is_signed<Integer>::value && (engine() & 1u)) {
+                d = Integer(0 - d);
+            }
+        }
+        return divisors;
+    }
+
+    template <typename Integer>
+    std::vector<Integer> random_dividends(std::size_t count)
+    {
+        std::mt19937_64 engine(7);
+        std::vector<Integer> dividends(count);
+        for (auto& n : dividends) {
+            n = Integer(engine());
+        }
+        return dividends;
+    }
+
+    fd_b::labels make_labels(const char* kind, const char* type, const char* policy,
+                             const char* width, divisor_class c)
+    {
+        return { { "kind", kind }, { "type", type }, { "policy", policy },
+                 { "width", width }, { "divisor_class", class_name(c) } };
+    }
+
+    std::string make_name(const fd_b::labels& properties)
+    {
+        std::string name;
+        for (auto& property : properties) {
+            name += (name.empty() ? "" : "/") + property.second;
+        }
+        return name;
+    }
+
+    /// Throughput
+
+    template <typename Integer>
+    void native_throughput(fd_b::benchmark_context& context, divisor_class c)
+    {
+        auto input = random_dividends<Integer>(array_size);
+        std::vector<Integer> output(array_size);
+        auto properties = make_labels("throughput", type_name<Integer>(), "native", "scalar", c);
+        context.run(make_name(properties), properties, array_size, [&] {
+            // An opaque divisor keeps the compiler from strength reducing the division itself.
+            Integer d = fd_b::opaque(class_divisor<Integer>(c));
+            for (std::size_t i = 0; i != array_size; ++i) {
+                output[i] = Integer(input[i] / d);
+            }
+            fd_b::do_not_optimize(output[0]);
+        });
+    }
+
+    template <typename Integer, template <typename, bool> class DivisionPolicy>
+    void policy_throughput(fd_b::benchmark_context& context, divisor_class c)
+    {
+        auto input = random_dividends<Integer>(array_size);
+        std::vector<Integer> output(array_size);
+        const constant_divider<Integer, DivisionPolicy> divider(class_divisor<Integer>(c));
+
+        const simd_level levels[] = { simd_level::scalar, simd_level::sse41, simd_level::avx2, simd_level::avx512 };
+        const char* widths[] = { "scalar", "__m128i", "__m256i", "__m512i" };
+        const bool simd = fast_division::has_simd_kernels<Integer, DivisionPolicy>::value;
+        for (int level = 0; level != (simd ? 4 : 1); ++level) {
+            if (fast_division::force_simd_level(levels[level]) != levels[level]) {
+                break;
+            }
+            auto properties = make_labels("throughput", type_name<Integer>(), policy_name<DivisionPolicy>(), widths[level], c);
+            context.run(make_name(properties), properties, array_size, [&] {
+                divider.divide(input.data(), output.data(), array_size);
+                fd_b::do_not_optimize(output[0]);
+            });
+        }
+        fast_division::reset_simd_level();
+    }
+
+    /// Remainder throughput, one element at a time, since hash bucket indexing and other users
+    /// of remainder take it from scalar code. fastmod takes it from the fractional part of the
+    /// quotient rather than by multiplying the quotient back.
+
+    template <typename Integer>
+    void native_remainder_throughput(fd_b::benchmark_context& context, divisor_class c)
+    {
+        auto input = random_dividends<Integer>(array_size);
+        std::vector<Integer> output(array_size);
+        auto properties = make_labels("remainder_throughput", type_name<Integer>(), "native", "scalar", c);
+        context.run(make_name(properties), properties, array_size, [&] {
+            Integer d = fd_b::opaque(class_divisor<Integer>(c));
+            for (std::size_t i = 0; i != array_size; ++i) {
+                output[i] = Integer(input[i] % d);
+            }
+            fd_b::do_not_optimize(output[0]);
+        });
+    }
+
+    template <typename Integer, template <typename, bool> class DivisionPolicy>
+    void policy_remainder_throughput(fd_b::benchmark_context& context, divisor_class c)
+    {
+        auto input = random_dividends<Integer>(array_size);
+        std::vector<Integer> output(array_size);
+        // The divider is built from an opaque divisor, so its constants are not folded into the loop.
+        const constant_divider<Integer, DivisionPolicy> divider(fd_b::opaque(class_divisor<Integer>(c)));
+        auto properties = make_labels("remainder_throughput", type_name<Integer>(), policy_name<DivisionPolicy>(), "scalar", c);
+        context.run(make_name(properties), properties, array_size, [&] {
+            for (std::size_t i = 0; i != array_size; ++i) {
+                output[i] = divider.remainder(input[i]);
+            }
+            fd_b::do_not_optimize(output[0]);
+        });
+    }
+
+    template <typename Integer>
+    void remainder_throughput_for(fd_b::benchmark_context& context)
+    {
+        for (auto c : divisor_classes) {
+            native_remainder_throughput<Integer>(context, c);
+            policy_remainder_throughput<Integer, fast_division::promotion_policy>(context, c);
+            policy_remainder_throughput<Integer, fast_division::decomposition_policy>(context, c);
+            policy_remainder_throughput<Integer, fast_division::fastmod_policy>(context, c);
+        }
+    }
+
+    /// Latency. Every dividend is the previous quotient mixed with a constant, so the
+    /// divisions cannot overlap and the quotient does not collapse to zero.
+
+    template <typename Integer>
+    constexpr Integer mix()
+    {
+        return Integer(std::numeric_limits<Integer>::max() / 5 * 3);
+    }
+
+    template <typename Integer>
+    void native_latency(fd_b::benchmark_context& context, divisor_class c)
+    {
+        auto properties = make_labels("latency", type_name<Integer>(), "native", "scalar", c);
+        context.run(make_name(properties), properties, chain_length, [&] {
+            Integer d = fd_b::opaque(class_divisor<Integer>(c));
+            Integer x = fd_b::opaque(mix<Integer>());
+            for (std::size_t i = 0; i != chain_length; ++i) {
+                x = Integer((x / d) ^ mix<Integer>());
+            }
+            fd_b::do_not_optimize(x);
+        });
+    }
+
+    template <typename Integer, template <typename, bool> class DivisionPolicy>
+    void policy_latency(fd_b::benchmark_context& context, divisor_class c)
+    {
+        const constant_divider<Integer, DivisionPolicy> divider(class_divisor<Integer>(c));
+        auto properties = make_labels("latency", type_name<Integer>(), policy_name<DivisionPolicy>(), "scalar", c);
+        context.run(make_name(properties), properties, chain_length, [&] {
+            Integer x = fd_b::opaque(mix<Integer>());
+            for (std::size_t i = 0; i != chain_length; ++i) {
+                x = Integer(divider(x) ^ mix<Integer>());
+            }
+            fd_b::do_not_optimize(x);
+        });
+    }
+
+    /// The vector chains call the base divider directly so that its kernels inline into
+    /// functions compiled for the same instruction set.
+
+    template <typename Base>
+    FAST_DIVISION_TARGET_SSE41
+    __m128i vector_chain_sse41(const Base& divider, __m128i x, __m128i mixer)
+    {
+        for (std::size_t i = 0; i != chain_length; ++i) {
+            x = _mm_xor_si128(divider(x), mixer);
+        }
+        return x;
+    }
+
+    template <typename Base>
+    FAST_DIVISION_TARGET_AVX2
+    void vector_chain_avx2(const Base& divider, uint32_t seed, uint32_t* result)
+    {
+        __m256i x = _mm256_set1_epi32(int(seed));
+        const __m256i mixer = _mm256_set1_epi32(int(seed));
+        for (std::size_t i = 0; i != chain_length; ++i) {
+            x = _mm256_xor_si256(divider(x), mixer);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(result), x);
+    }
+
+    template <typename Integer, typename Divider>
+    void vector_latency(fd_b::benchmark_context& context, divisor_class c, const char* policy)
+    {
+        const Divider divider(class_divisor<Integer>(c));
+        const uint32_t seed = uint32_t(mix<Integer>());
+        if (fast_division::detected_simd_level() >= simd_level::sse41) {
+            auto properties = make_labels("latency", type_name<Integer>(), policy, "__m128i", c);
+            context.run(make_name(properties), properties, chain_length, [&] {
+                __m128i mixer = _mm_set1_epi32(int(fd_b::opaque(seed)));
+                fd_b::do_not_optimize(vector_chain_sse41(divider, mixer, mixer));
+            });
+        }
+        if (fast_division::detected_simd_level() >= simd_level::avx2) {
+            auto properties = make_labels("latency", type_name<Integer>(), policy, "__m256i", c);
+            uint32_t result[8];
+            context.run(make_name(properties), properties, chain_length, [&] {
+                vector_chain_avx2(divider, fd_b::opaque(seed), result);
+                fd_b::do_not_optimize(result);
+            });
+        }
+    }
+
+    template <typename Integer, template <typename, bool> class DivisionPolicy>
+    void vector_latency(fd_b::benchmark_context& context, divisor_class c)
+    {
+        using base = constant_divider_base<Integer, std::is_signed<Integer>::value, DivisionPolicy>;
+        vector_latency<Integer, base>(context, c, policy_name<DivisionPolicy>());
+    }
+
+    /// The branch-free divider runs one sequence for every divisor.
+
+    template <typename Integer>
+    void branchfree_throughput(fd_b::benchmark_context& context, divisor_class c)
+    {
+        auto input = random_dividends<Integer>(array_size);
+        std::vector<Integer> output(array_size);
+        const fast_division::branchfree_divider<Integer> divider(class_divisor<Integer>(c));
+        auto properties = make_labels("throughput", type_name<Integer>(), "branchfree", "scalar", c);
+        context.run(make_name(properties), properties, array_size, [&] {
+            for (std::size_t i = 0; i != array_size; ++i) {
+                output[i] = divider(input[i]);
+            }
+            fd_b::do_not_optimize(output[0]);
+        });
+    }
+
+    template <typename Integer>
+    void branchfree_latency(fd_b::benchmark_context& context, divisor_class c)
+    {
+        const fast_division::branchfree_divider<Integer> divider(class_divisor<Integer>(c));
+        auto properties = make_labels("latency", type_name<Integer>(), "branchfree", "scalar", c);
+        context.run(make_name(properties), properties, chain_length, [&] {
+            Integer x = fd_b::opaque(mix<Integer>());
+            for (std::size_t i = 0; i != chain_length; ++i) {
+                x = Integer(divider(x) ^ mix<Integer>());
+            }
+            fd_b::do_not_optimize(x);
+        });
+    }
+
+    /// Construction
+
+    template <typename Integer, template <typename, bool> class DivisionPolicy>
+    void policy_construction(fd_b::benchmark_context& context, divisor_class c)
+    {
+        auto divisors = class_divisors<Integer>(c, array_size);
+        auto properties = make_labels("construction", type_name<Integer>(), policy_name<DivisionPolicy>(), "scalar", c);
+        context.run(make_name(properties), properties, array_size, [&] {
+            for (auto d : divisors) {
+                constant_divider<Integer, DivisionPolicy> divider(d);
+                fd_b::do_not_optimize(divider);
+            }
+        });
+    }
+
+    /// Building the dividers of many divisors into a vector that is reused, as the dividers of a
+    /// query would be, one by one and in a batch.
+    template <typename Integer, template <typename, bool> class DivisionPolicy>
+    void batch_construction(fd_b::benchmark_context& context, divisor_class c)
+    {
+        auto divisors = class_divisors<Integer>(c, array_size);
+        std::vector<constant_divider<Integer, DivisionPolicy>> dividers;
+        dividers.reserve(array_size);
+        auto properties = make_labels("construction", type_name<Integer>(), policy_name<DivisionPolicy>(), "append", c);
+        context.run(make_name(properties), properties, array_size, [&] {
+            dividers.clear();
+            for (auto d : divisors) {
+                dividers.emplace_back(d);
+            }
+            fd_b::do_not_optimize(dividers.back());
+        });
+        properties = make_labels("construction", type_name<Integer>(), policy_name<DivisionPolicy>(), "batch", c);
+        context.run(make_name(properties), properties, array_size, [&] {
+            dividers.clear();
+            fast_division::append_dividers(divisors.data(), divisors.size(), dividers);
+            fd_b::do_not_optimize(dividers.back());
+        });
+    }
+
+    /// Parallel scaling. The arrays are much larger than the last level cache, so the
+    /// threads compete for memory bandwidth as they would on a real column.
+
+    template <typename Integer>
+    void parallel_scaling_for(fd_b::benchmark_context& context)
+    {
+        auto input = random_dividends<Integer>(parallel_array_size);
+        std::vector<Integer> output(parallel_array_size);
+        const constant_divider<Integer> divider(class_divisor<Integer>(divisor_class::small_odd));
+        const unsigned hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<unsigned> thread_counts;
+        for (unsigned threads = 1; threads < hardware_threads; threads *= 2) {
+            thread_counts.push_back(threads);
+        }
+        thread_counts.push_back(hardware_threads);
+        for (auto threads : thread_counts) {
+            fast_division::division_pool pool(threads);
+            fd_b::labels properties = { { "kind", "parallel" }, { "type", type_name<Integer>() },
+                                        { "policy", "promotion" }, { "threads", std::to_string(threads) } };
+            context.run(make_name(properties), properties, parallel_array_size, [&] {
+                fast_division::parallel_divide(divider, input.data(), output.data(), parallel_array_size, pool);
+                fd_b::do_not_optimize(output[0]);
+            });
+        }
+    }
+
+    /// Formatting. The values have random lengths, as in logs and serialized records, so the
+    /// length is not predictable.
+
+    template <typename Integer>
+    std::vector<Integer> mixed_length_values(std::size_t count)
+    {
+        std::mt19937_64 engine(11);
+        std::vector<Integer> values(count);
+        for (auto& n : values) {
+            n = Integer(Integer(engine()) >> (engine() % (8 * sizeof(Integer))));
+        }
+        return values;
+    }
+
+    template <typename Integer, typename Format>
+    void formatting(fd_b::benchmark_context& context, const char* method, const char* base, Format&& format)
+    {
+        auto values = mixed_length_values<Integer>(array_size);
+        std::vector<char> output(array_size * (8 * sizeof(Integer) + 2));
+        fd_b::labels properties = { { "kind", "format" }, { "type", type_name<Integer>() },
+                                    { "method", method }, { "base", base } };
+        context.run(make_name(properties), properties, array_size, [&] {
+            char* out = output.data();
+            for (auto n : values) {
+                out = format(out, n);
+                *out++ = ' ';
+            }
+            fd_b::do_not_optimize(output[0]);
+        });
+    }
+
+    template <typename Integer>
+    void formatting_for(fd_b::benchmark_context& context)
+    {
+        formatting<Integer>(context, "to_chars", "10", [](char* out, Integer n) {
+            return std::to_chars(out, out + 8 * sizeof(Integer) + 1, n).ptr;
+        });
+        formatting<Integer>(context, "format_decimal", "10", [](char* out, Integer n) {
+            return fast_division::format_decimal(out, n);
+        });
+        formatting<Integer>(context, "to_chars", "16", [](char* out, Integer n) {
+            return std::to_chars(out, out + 8 * sizeof(Integer) + 1, n, 16).ptr;
+        });
+        const fast_division::radix_formatter<Integer> hexadecimal(16);
+        formatting<Integer>(context, "radix_formatter", "16", [&](char* out, Integer n) {
+            return hexadecimal(out, n);
+        });
+    }
+
+    /// Hash map lookups, half of which hit. Every variant counts the hits. Random keys suit every table, strided keys are
+    /// multiples of 64 and fill only every 64th bucket of a power of two table under the
+    /// identity std::hash.
+
+    std::vector<uint64_t> hash_map_keys(const char* keys, std::size_t count)
+    {
+        std::mt19937_64 engine(13);
+        std::vector<uint64_t> values(count);
+        for (std::size_t i = 0; i != count; ++i) {
+            values[i] = std::string(keys) == "random" ? engine() : 64 * uint64_t(i);
+        }
+        return values;
+    }
+
+    std::vector<uint64_t> hash_map_lookups(const std::vector<uint64_t>& inserted)
+    {
+        std::mt19937_64 engine(17);
+        std::vector<uint64_t> lookups(array_size);
+        for (auto& k : lookups) {
+            k = inserted[engine() % inserted.size()] + (engine() & 1u);
+        }
+        return lookups;
+    }
+
+    template <typename Map, typename Lookup>
+    void hash_lookup(fd_b::benchmark_context& context, const char* table, const char* keys, Lookup&& lookup)
+    {
+        auto inserted = hash_map_keys(keys, hash_map_size);
+        auto lookups = hash_map_lookups(inserted);
+        Map map;
+        for (std::size_t i = 0; i != inserted.size(); ++i) {
+            map[inserted[i]] = uint32_t(i);
+        }
+        fd_b::labels properties = { { "kind", "hash_lookup" }, { "table", table }, { "keys", keys } };
+        context.run(make_name(properties), properties, array_size, [&] {
+            fd_b::do_not_optimize(lookup(map, lookups));
+        });
+    }
+
+    template <typename Buckets>
+    void flat_hash_lookup(fd_b::benchmark_context& context, const char* table, const char* keys)
+    {
+        using map_type = fast_division::flat_hash_map<uint64_t, uint32_t, std::hash<uint64_t>, Buckets>;
+        hash_lookup<map_type>(context, table, keys, [](map_type& map, const std::vector<uint64_t>& lookups) {
+            uint64_t sum = 0;
+            for (auto k : lookups) {
+                auto found = map.find(k);
+                sum += found != nullptr;
+            }
+            return sum;
+        });
+        std::vector<uint32_t*> results(array_size);
+        std::string batched = std::string(table) + "_batched";
+        hash_lookup<map_type>(context, batched.c_str(), keys, [&](map_type& map, const std::vector<uint64_t>& lookups) {
+            map.find(lookups.data(), lookups.size(), results.data());
+            uint64_t sum = 0;
+            for (auto found : results) {
+                sum += found != nullptr;
+            }
+            return sum;
+        });
+    }
+
+    /// Footprint
+
+    /// Divides by dividers picked at random from a table of count of them, so for large
+    /// tables nearly every division misses the caches on its divider.
+    template <typename Divider, typename Integer>
+    void footprint_lookup(fd_b::benchmark_context& context, const char* layout,
+                          const std::vector<Divider>& dividers, const std::vector<Integer>& dividends)
+    {
+        std::mt19937_64 engine(11);
+        std::vector<uint32_t> indices(array_size);
+        for (auto& index : indices) {
+            index = uint32_t(engine() % dividers.size());
+        }
+        fd_b::labels properties = { { "kind", "footprint" }, { "type", type_name<Integer>() }, { "layout", layout },
+                                    { "dividers", std::to_string(dividers.size()) },
+                                    { "bytes_per_divider", std::to_string(sizeof(Divider)) } };
+        context.run(make_name(properties), properties, array_size, [&] {
+            Integer sum = 0;
+            for (std::size_t i = 0; i != array_size; ++i) {
+                sum = Integer(sum + dividers[indices[i]](dividends[i]));
+            }
+            fd_b::do_not_optimize(sum);
+        });
+    }
+
+    template <typename Integer>
+    void footprint_for(fd_b::benchmark_context& context, std::size_t max_count)
+    {
+        auto dividends = random_dividends<Integer>(array_size);
+        for (std::size_t count = std::size_t(1) << 12; count <= max_count; count <<= 4) {
+            auto divisors = class_divisors<Integer>(divisor_class::large, count);
+            auto dividers = fast_division::make_dividers(divisors);
+            footprint_lookup(context, "constant", dividers, dividends);
+            std::vector<fast_division::packed_divider<Integer>> packed(dividers.begin(), dividers.end());
+            dividers = {};
+            footprint_lookup(context, "packed", packed, dividends);
+        }
+    }
+
+    /// Double word division
+
+    /// Divides (high, low) pairs by the large divisor of the type with method. "throughput"
+    /// divides independent pairs, "latency" feeds every remainder into the next high word as
+    /// the long division of a multi-word number does.
+    template <typename UInteger, typename Divide>
+    void double_word_method(fd_b::benchmark_context& context, const char* method, Divide&& divide)
+    {
+        const UInteger d = class_divisor<UInteger>(divisor_class::large);
+        auto lows = random_dividends<UInteger>(array_size);
+        std::vector<UInteger> highs(lows.rbegin(), lows.rend());
+        for (auto& high : highs) {
+            high = UInteger(high % d);
+        }
+        fd_b::labels properties = { { "kind", "double_word" }, { "type", type_name<UInteger>() },
+                                    { "method", method }, { "mode", "throughput" } };
+        context.run(make_name(properties), properties, array_size, [&] {
+            UInteger sum = 0;
+            for (std::size_t i = 0; i != array_size; ++i) {
+                UInteger r = 0;
+                sum = UInteger(sum + divide(highs[i], lows[i], r) + r);
+            }
+            fd_b::do_not_optimize(sum);
+        });
+        properties.back().second = "latency";
+        context.run(make_name(properties), properties, array_size, [&] {
+            UInteger r = 0;
+            for (std::size_t i = 0; i != array_size; ++i) {
+                divide(r, lows[i], r);
+            }
+            fd_b::do_not_optimize(r);
+        });
+    }
+
+    template <typename UInteger>
+    void double_word_for(fd_b::benchmark_context& context)
+    {
+        const fast_division::double_word_divider<UInteger> divider(class_divisor<UInteger>(divisor_class::large));
+        double_word_method<UInteger>(context, "reciprocal", [&](UInteger high, UInteger low, UInteger& r) {
+            return divider.divide(high, low, r);
+        });
+        double_word_method<UInteger>(context, "half_words", [](UInteger high, UInteger low, UInteger& r) {
+            return fast_division::utility::divide_double_word(high, low, fd_b::opaque(class_divisor<UInteger>(divisor_class::large)), r);
+        });
+        double_word_method<UInteger>(context, "promotion", [](UInteger high, UInteger low, UInteger& r) {
+            using p_type = fast_division::utility::promotion_t<UInteger>;
+            const p_type n = p_type(p_type(high) << (8 * sizeof(UInteger))) | low;
+            const UInteger d = fd_b::opaque(class_divisor<UInteger>(divisor_class::large));
+            const UInteger q = UInteger(n / d);
+            r = UInteger(low - fast_division::utility::low_mult(q, d));
+            return q;
+        });
+    }
+
+    /// Multi-word division
+
+    /// The hardware double-word division: div on the promoted type, or divq for 64-bit limbs.
+    uint32_t hardware_divide(uint32_t high, uint32_t low, uint32_t divisor, uint32_t& remainder)
+    {
+        const uint32_t q = uint32_t(((uint64_t(high) << 32) | low) / divisor);
+        remainder = low - q * divisor;
+        return q;
+    }
+
+    uint64_t hardware_divide(uint64_t high, uint64_t low, uint64_t divisor, uint64_t& remainder)
+    {
+        const uint64_t q = fast_division::utility::divide_double_word_native(high, low, divisor);
+        remainder = low - q * divisor;
+        return q;
+    }
+
+    template <typename Limb>
+    void limb_division_for(fd_b::benchmark_context& context)
+    {
+        const Limb d = class_divisor<Limb>(divisor_class::large);
+        const fast_division::double_word_divider<Limb> divider(d);
+        std::vector<std::vector<Limb>> numbers;
+        std::vector<const Limb*> pointers;
+        std::vector<std::size_t> sizes(bignum_count, bignum_limbs);
+        for (std::size_t k = 0; k != bignum_count; ++k) {
+            numbers.push_back(random_dividends<Limb>(bignum_limbs + k));
+            numbers.back().resize(bignum_limbs);
+            pointers.push_back(numbers.back().data());
+        }
+        std::vector<Limb> quotient(bignum_limbs);
+        std::vector<Limb> remainders(bignum_count);
+        auto run = [&](const char* operation, const char* method, uint64_t limbs, auto&& body) {
+            fd_b::labels properties = { { "kind", "limb_division" }, { "type", type_name<Limb>() },
+                                        { "operation", operation }, { "method", method } };
+            context.run(make_name(properties), properties, limbs, body);
+        };
+
+        run("quotient", "reciprocal", bignum_limbs, [&] {
+            fd_b::do_not_optimize(fast_division::divide_limbs(numbers[0].data(), bignum_limbs, divider, quotient.data()));
+        });
+        run("quotient", "hardware", bignum_limbs, [&] {
+            const Limb divisor = fd_b::opaque(d);
+            Limb r = 0;
+            for (std::size_t i = bignum_limbs; i != 0; --i) {
+                quotient[i - 1] = hardware_divide(r, numbers[0][i - 1], divisor, r);
+            }
+            fd_b::do_not_optimize(r);
+        });
+        run("remainder", "reciprocal", bignum_limbs, [&] {
+            fd_b::do_not_optimize(fast_division::remainder_limbs(numbers[0].data(), bignum_limbs, divider));
+        });
+        run("remainder", "hardware", bignum_limbs, [&] {
+            const Limb divisor = fd_b::opaque(d);
+            Limb r = 0;
+            for (std::size_t i = bignum_limbs; i != 0; --i) {
+                hardware_divide(r, numbers[0][i - 1], divisor, r);
+            }
+            fd_b::do_not_optimize(r);
+        });
+        run("batch_remainder", "reciprocal", bignum_count * bignum_limbs, [&] {
+            fast_division::remainder_limbs(pointers.data(), sizes.data(), bignum_count, divider, remainders.data());
+            fd_b::do_not_optimize(remainders[0]);
+        });
+        run("batch_remainder", "hardware", bignum_count * bignum_limbs, [&] {
+            const Limb divisor = fd_b::opaque(d);
+            for (std::size_t k = 0; k != bignum_count; ++k) {
+                Limb r = 0;
+                for (std::size_t i = bignum_limbs; i != 0; --i) {
+                    hardware_divide(r, numbers[k][i - 1], divisor, r);
+                }
+                remainders[k] = r;
+            }
+            fd_b::do_not_optimize(remainders[0]);
+        });
+    }
+
+    /// Modular arithmetic
+
+    /// The largest primes below 2^32 and 2^64, odd as Montgomery requires.
+    template <typename UInteger> UInteger large_prime();
+    template <> uint32_t large_prime<uint32_t>() { return 4294967291u; }
+    template <> uint64_t large_prime<uint64_t>() { return 18446744073709551557u; }
+
+    fd_b::labels modular_labels(const char* operation, const char* type, const char* method, const char* width)
+    {
+        return { { "kind", "modular" }, { "operation", operation }, { "type", type },
+                 { "method", method }, { "width", width } };
+    }
+
+    template <typename UInteger, typename Mulmod>
+    void mulmod_scalar(fd_b::benchmark_context& context, const char* method, Mulmod&& mulmod)
+    {
+        const UInteger m = large_prime<UInteger>();
+        auto a = random_dividends<UInteger>(array_size);
+        auto b = a;
+        std::reverse(b.begin(), b.end());
+        for (std::size_t i = 0; i != array_size; ++i) {
+            a[i] = UInteger(a[i] % m);
+            b[i] = UInteger(b[i] % m);
+        }
+        std::vector<UInteger> output(array_size);
+        auto properties = modular_labels("mulmod", type_name<UInteger>(), method, "scalar");
+        context.run(make_name(properties), properties, array_size, [&] {
+            for (std::size_t i = 0; i != array_size; ++i) {
+                output[i] = mulmod(a[i], b[i]);
+            }
+            fd_b::do_not_optimize(output[0]);
+        });
+    }
+
+    /// levels are those the context has kernels for, from scalar up.
+    template <typename Modulus>
+    void mulmod_array(fd_b::benchmark_context& context, const char* method, std::vector<simd_level> levels)
+    {
+        const Modulus modulus(large_prime<uint32_t>());
+        auto a = random_dividends<uint32_t>(array_size);
+        auto b = a;
+        std::reverse(b.begin(), b.end());
+        for (std::size_t i = 0; i != array_size; ++i) {
+            a[i] %= modulus.modulus();
+            b[i] %= modulus.modulus();
+        }
+        std::vector<uint32_t> output(array_size);
+        for (auto level : levels) {
+            if (fast_division::force_simd_level(level) != level) {
+                break;
+            }
+            const char* width = level == simd_level::scalar ? "array_scalar" :
+                                level == simd_level::sse41 ? "__m128i" : "__m256i";
+            auto properties = modular_labels("mulmod", "uint32_t", method, width);
+            context.run(make_name(properties), properties, array_size, [&] {
+                modulus.mulmod(a.data(), b.data(), output.data(), array_size);
+                fd_b::do_not_optimize(output[0]);
+            });
+        }
+        fast_division::reset_simd_level();
+    }
+
+    /// Modular exponentiation with 64-bit exponents, a chain of about 96 dependent products.
+    template <typename UInteger, typename Powmod>
+    void powmod_latency(fd_b::benchmark_context& context, const char* method, Powmod&& powmod)
+    {
+        auto bases = random_dividends<UInteger>(64);
+        auto exponents = random_dividends<uint64_t>(64);
+        auto properties = modular_labels("powmod", type_name<UInteger>(), method, "scalar");
+        context.run(make_name(properties), properties, bases.size(), [&] {
+            UInteger x = 0;
+            for (std::size_t i = 0; i != bases.size(); ++i) {
+                x = UInteger(x + powmod(UInteger(bases[i] % large_prime<UInteger>()), exponents[i]));
+            }
+            fd_b::do_not_optimize(x);
+        });
+    }
+
+    template <typename UInteger>
+    void modular_for(fd_b::benchmark_context& context)
+    {
+        using p_type = fast_division::utility::promotion_t<UInteger>;
+        const UInteger m = large_prime<UInteger>();
+        const fast_division::barrett_modulus<UInteger> barrett(m);
+        const fast_division::montgomery_modulus<UInteger> montgomery(m);
+        mulmod_scalar<UInteger>(context, "native", [](UInteger x, UInteger y) {
+            return UInteger(p_type(x) * y % fd_b::opaque(large_prime<UInteger>()));
+        });
+        mulmod_scalar<UInteger>(context, "barrett", [&](UInteger x, UInteger y) {
+            return barrett.mulmod(x, y);
+        });
+        mulmod_scalar<UInteger>(context, "montgomery", [&](UInteger x, UInteger y) {
+            return montgomery.mulmod(x, y);
+        });
+        powmod_latency<UInteger>(context, "native", [](UInteger x, uint64_t e) {
+            const UInteger modulus = fd_b::opaque(large_prime<UInteger>());
+            UInteger result = 1;
+            for (; e != 0; e >>= 1) {
+                if (e & 1) {
+                    result = UInteger(p_type(result) * x % modulus);
+                }
+                x = UInteger(p_type(x) * x % modulus);
+            }
+            return result;
+        });
+        powmod_latency<UInteger>(context, "barrett", [&](UInteger x, uint64_t e) {
+            return barrett.powmod(x, e);
+        });
+        powmod_latency<UInteger>(context, "montgomery", [&](UInteger x, uint64_t e) {
+            return montgomery.from_montgomery(montgomery.powmod(montgomery.to_montgomery(x), e));
+        });
+    }
+
+    /// Mixed-radix decomposition
+
+    /// Digits of 32-bit indices by Radices radices, chained / and % against the mixed_radix
+    /// system one index and whole arrays at a time.
+    template <std::size_t Radices>
+    void mixed_radix_for(fd_b::benchmark_context& context, const char* system,
+                         const std::array<uint32_t, Radices>& radices)
+    {
+        constexpr std::size_t num_digits = Radices + 1;
+        const fast_division::mixed_radix<uint32_t, Radices> decomposer(radices);
+        auto indices = random_dividends<uint32_t>(array_size);
+        std::array<std::vector<uint32_t>, num_digits> digits;
+        std::array<uint32_t*, num_digits> digit_pointers;
+        for (std::size_t k = 0; k != num_digits; ++k) {
+            digits[k].resize(array_size);
+            digit_pointers[k] = digits[k].data();
+        }
+        auto labels = [&](const char* method, const char* width) {
+            return fd_b::labels{ { "kind", "mixed_radix" }, { "system", system }, { "type", "uint32_t" },
+                                 { "method", method }, { "width", width } };
+        };
+        auto properties = labels("native", "scalar");
+        context.run(make_name(properties), properties, array_size, [&] {
+            for (std::size_t i = 0; i != array_size; ++i) {
+                uint32_t n = indices[i];
+                for (std::size_t k = 0; k != Radices; ++k) {
+                    const uint32_t r = fd_b::opaque(radices[k]);
+                    digits[k][i] = n % r;
+                    n /= r;
+                }
+                digits[Radices][i] = n;
+            }
+            fd_b::do_not_optimize(digits[0][0]);
+        });
+        properties = labels("mixed_radix", "scalar");
+        context.run(make_name(properties), properties, array_size, [&] {
+            for (std::size_t i = 0; i != array_size; ++i) {
+                const auto d = decomposer.decompose(indices[i]);
+                for (std::size_t k = 0; k != num_digits; ++k) {
+                    digits[k][i] = d[k];
+                }
+            }
+            fd_b::do_not_optimize(digits[0][0]);
+        });
+        const simd_level levels[] = { simd_level::scalar, simd_level::sse41, simd_level::avx2, simd_level::avx512 };
+        const char* widths[] = { "array_scalar", "__m128i", "__m256i", "__m512i" };
+        for (int level = 0; level != 4; ++level) {
+            if (fast_division::force_simd_level(levels[level]) != levels[level]) {
+                break;
+            }
+            properties = labels("mixed_radix", widths[level]);
+            context.run(make_name(properties), properties, array_size, [&] {
+                decomposer.decompose(indices.data(), array_size, digit_pointers.data());
+                fd_b::do_not_optimize(digits[0][0]);
+            });
+        }
+        fast_division::reset_simd_level();
+    }
+
+    template <typename Integer>
+    void throughput_for(fd_b::benchmark_context& context)
+    {
+        for (auto c : divisor_classes) {
+            native_throughput<Integer>(context, c);
+            policy_throughput<Integer, fast_division::promotion_policy>(context, c);
+            policy_throughput<Integer, fast_division::decomposition_policy>(context, c);
+            branchfree_throughput<Integer>(context, c);
+        }
+    }
+
+    template <typename Integer>
+    void latency_for(fd_b::benchmark_context& context)
+    {
+        for (auto c : divisor_classes) {
+            native_latency<Integer>(context, c);
+            policy_latency<Integer, fast_division::promotion_policy>(context, c);
+            policy_latency<Integer, fast_division::decomposition_policy>(context, c);
+            branchfree_latency<Integer>(context, c);
+        }
+    }
+
+    template <typename Integer>
+    void construction_for(fd_b::benchmark_context& context)
+    {
+        for (auto c : divisor_classes) {
+            policy_construction<Integer, fast_division::promotion_policy>(context, c);
+            policy_construction<Integer, fast_division::decomposition_policy>(context, c);
+            batch_construction<Integer, fast_division::promotion_policy>(context, c);
+        }
+    }
+
+}
+
+void fd_b::division_throughput(benchmark_context& context)
+{
+    throughput_for<uint32_t>(context);
+    throughput_for<int32_t>(context);
+    throughput_for<uint64_t>(context);
+    throughput_for<int64_t>(context);
+    // The fastmod reciprocal is twice the word size, so it only exists up to 32 bits.
+    for (auto c : divisor_classes) {
+        policy_throughput<uint32_t, fast_division::fastmod_policy>(context, c);
+        policy_throughput<int32_t, fast_division::fastmod_policy>(context, c);
+    }
+    // Sample scaling: 16 and 32 lanes per 256-bit vector.
+    for (auto c : divisor_classes) {
+        native_throughput<uint16_t>(context, c);
+        policy_throughput<uint16_t, fast_division::promotion_policy>(context, c);
+        native_throughput<int16_t>(context, c);
+        policy_throughput<int16_t, fast_division::promotion_policy>(context, c);
+        native_throughput<uint8_t>(context, c);
+        policy_throughput<uint8_t, fast_division::promotion_policy>(context, c);
+        native_throughput<int8_t>(context, c);
+        policy_throughput<int8_t, fast_division::promotion_policy>(context, c);
+    }
+    remainder_throughput_for<uint32_t>(context);
+    remainder_throughput_for<int32_t>(context);
+}
+
+void fd_b::division_latency(benchmark_context& context)
+{
+    latency_for<uint32_t>(context);
+    latency_for<int32_t>(context);
+    latency_for<uint64_t>(context);
+    latency_for<int64_t>(context);
+    for (auto c : divisor_classes) {
+        policy_latency<uint32_t, fast_division::fastmod_policy>(context, c);
+        policy_latency<int32_t, fast_division::fastmod_policy>(context, c);
+        vector_latency<uint32_t, fast_division::promotion_policy>(context, c);
+        vector_latency<uint32_t, fast_division::decomposition_policy>(context, c);
+        vector_latency<int32_t, fast_division::promotion_policy>(context, c);
+        vector_latency<int32_t, fast_division::decomposition_policy>(context, c);
+        vector_latency<uint32_t, fast_division::branchfree_divider<uint32_t>>(context, c, "branchfree");
+        vector_latency<int32_t, fast_division::branchfree_divider<int32_t>>(context, c, "branchfree");
+    }
+}
+
+void fd_b::divider_construction(benchmark_context& context)
+{
+    construction_for<uint32_t>(context);
+    construction_for<int32_t>(context);
+    construction_for<uint64_t>(context);
+    construction_for<int64_t>(context);
+    for (auto c : divisor_classes) {
+        policy_construction<uint32_t, fast_division::fastmod_policy>(context, c);
+        policy_construction<int32_t, fast_division::fastmod_policy>(context, c);
+    }
+}
+
+void fd_b::parallel_scaling(benchmark_context& context)
+{
+    parallel_scaling_for<uint32_t>(context);
+    parallel_scaling_for<int32_t>(context);
+    parallel_scaling_for<uint64_t>(context);
+    parallel_scaling_for<uint8_t>(context);
+}
+
+void fd_b::integer_formatting(benchmark_context& context)
+{
+    formatting_for<uint32_t>(context);
+    formatting_for<int32_t>(context);
+    formatting_for<uint64_t>(context);
+    formatting_for<int64_t>(context);
+    auto values = mixed_length_values<uint32_t>(array_size);
+    std::vector<char> output(array_size * (fast_division::max_decimal_size<uint32_t>() + 1));
+    const simd_level levels[] = { simd_level::scalar, simd_level::avx2 };
+    const char* methods[] = { "batch_scalar", "batch___m256i" };
+    for (int level = 0; level != 2; ++level) {
+        if (fast_division::force_simd_level(levels[level]) != levels[level]) {
+            break;
+        }
+        fd_b::labels properties = { { "kind", "format" }, { "type", "uint32_t" },
+                                    { "method", methods[level] }, { "base", "10" } };
+        context.run(make_name(properties), properties, array_size, [&] {
+            fd_b::do_not_optimize(*fast_division::format_decimal(values.data(), array_size, output.data(), ' '));
+        });
+    }
+    fast_division::reset_simd_level();
+}
+
+void fd_b::hash_table_lookup(benchmark_context& context)
+{
+    using map_type = std::unordered_map<uint64_t, uint32_t>;
+    for (const char* keys : { "random", "strided" }) {
+        flat_hash_lookup<fast_division::prime_buckets<uint32_t>>(context, "prime", keys);
+        flat_hash_lookup<fast_division::prime_buckets<uint32_t, fast_division::fastmod_policy>>(context, "prime_fastmod", keys);
+        flat_hash_lookup<fast_division::power_of_two_buckets<uint32_t>>(context, "power_of_two", keys);
+        hash_lookup<map_type>(context, "unordered_map", keys, [](map_type& map, const std::vector<uint64_t>& lookups) {
+            uint64_t sum = 0;
+            for (auto k : lookups) {
+                auto found = map.find(k);
+                sum += found != map.end();
+            }
+            return sum;
+        });
+    }
+}
+
+void fd_b::divider_footprint(benchmark_context& context)
+{
+    footprint_for<uint32_t>(context, std::size_t(1) << 24);
+    footprint_for<int32_t>(context, std::size_t(1) << 24);
+    footprint_for<uint64_t>(context, std::size_t(1) << 24);
+}
+
+void fd_b::double_word_division(benchmark_context& context)
+{
+    double_word_for<uint32_t>(context);
+#if defined(FAST_DIVISION_HAS_INT128)
+    double_word_for<uint64_t>(context);
+#endif
+    double_word_method<uint64_t>(context, "divq", [](uint64_t high, uint64_t low, uint64_t& r) {
+        const uint64_t d = fd_b::opaque(class_divisor<uint64_t>(divisor_class::large));
+        const uint64_t q = fast_division::utility::divide_double_word_native(high, low, d);
+        r = low - q * d;
+        return q;
+    });
+}
+
+void fd_b::limb_division(benchmark_context& context)
+{
+    limb_division_for<uint32_t>(context);
+    limb_division_for<uint64_t>(context);
+}
+
+void fd_b::modular_arithmetic(benchmark_context& context)
+{
+    modular_for<uint32_t>(context);
+#if defined(FAST_DIVISION_HAS_INT128)
+    modular_for<uint64_t>(context);
+#endif
+    const constant_divider<uint64_t> product_divider(large_prime<uint32_t>());
+    mulmod_scalar<uint32_t>(context, "constant_divider", [&](uint32_t x, uint32_t y) {
+        return uint32_t(product_divider.remainder(uint64_t(x) * y));
+    });
+    mulmod_array<fast_division::barrett_modulus<uint32_t>>(context, "barrett", { simd_level::scalar, simd_level::avx2 });
+    mulmod_array<fast_division::montgomery_modulus<uint32_t>>(context, "montgomery",
+        { simd_level::scalar, simd_level::sse41, simd_level::avx2 });
+}
+
+void fd_b::mixed_radix(benchmark_context& context)
+{
+    mixed_radix_for<2>(context, "grid", { { 640, 480 } });
+    mixed_radix_for<3>(context, "duration", { { 60, 60, 24 } });
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "benchmark_utility.hpp"
+
+namespace fast_division {
+
+    namespace benchmarks {
+
+        /// Bulk division of an array, scalar and at every SIMD width the processor supports, and
+        /// the remainder of every element against the % operator.
+        void division_throughput(benchmark_context& context);
+
+        /// A chain of divisions where every dividend depends on the previous quotient.
+        void division_latency(benchmark_context& context);
+
+        /// Building a divider from a runtime divisor.
+        void divider_construction(benchmark_context& context);
+
+        /// Bulk division of an array much larger than the caches on 1, 2, 4, ... threads.
+        void parallel_scaling(benchmark_context& context);
+
+        /// Integer to text conversion against std::to_chars, one value and a batch at a time.
+        void integer_formatting(benchmark_context& context);
+
+        /// Hash map lookups with prime and power of two bucket counts against std::unordered_map.
+        /// Prime bucket indices are taken with the promotion and the fastmod remainders.
+        void hash_table_lookup(benchmark_context& context);
+
+        /// Division by dividers picked at random from tables from L1 to beyond the last level cache,
+        /// constant_divider against packed_divider.
+        void divider_footprint(benchmark_context& context);
+
+        /// Division of double-word dividends by a single-word divisor, independent and chained
+        /// through the remainder, against the hardware and half-word long division.
+        void double_word_division(benchmark_context& context);
+
+        /// Long division of 1024-limb numbers by one limb, against a hardware division per limb.
+        void limb_division(benchmark_context& context);
+
+        /// Modular multiplication and exponentiation with Barrett and Montgomery contexts against
+        /// the % operator on the promoted product, one product and whole arrays at a time.
+        void modular_arithmetic(benchmark_context& context);
+
+        /// Flat indices to the digits of a 3D grid and of a duration, with chained / and %
+        /// against mixed_radix, one index and whole arrays at a time.
+        void mixed_radix(benchmark_context& context);
+
+    }
+
+}
@@ -1,10 +1,19 @@
 #include <iostream>
+#include <cerrno>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
 #include <immintrin.h>
 
 #include <fast_division/fast_division.hpp>
 #include <fast_division/fast_division_simd.hpp>
 #include <fast_division/division_policy.hpp>
+#include <fast_division/stream_division.hpp>
 
 using namespace std;
 
@@ -36,6 +45,33 @@ void interactive_division_unsigned_simd()
     }
 }
 
+void interactive_division_bulk()
+{
+    using fast_division::constant_divider;
+    uint32_t divisor;
+    size_t count;
+    while (!cin.eof()) {
+        cout << "Enter divisor:\n";
+        cin >> divisor;
+        if (cin.eof()) {
+            cin.clear();
+            break;
+        }
+        constant_divider<uint32_t> divider(divisor);
+        cout << "Enter number of dividends followed by the dividends:\n";
+        cin >> count;
+        vector<uint32_t> dividends(count);
+        for (auto& d : dividends) {
+            cin >> d;
+        }
+        divider.divide_in_place(dividends);
+        for (auto& q : dividends) {
+            cout << q << " ";
+        }
+        cout << "\n\n";
+    }
+}
+
 void interactive_division_unsigned()
 {
     using fast_division::constant_divider;
@@ -86,10 +122,108 @@ void interactive_division_signed()
     }
 }
 
-int main()
+void file_division_usage(const char* program)
+{
+    cerr << "Usage: " << program << " <type> <divisor> <input> [output] [--block-size bytes] [--threads n]\n"
+         << "Divides every value of a file of packed native-endian integers, in place unless an output is given.\n"
+         << "Types: uint8 int8 uint16 int16 uint32 int32 uint64 int64.\n"
+         << "Without arguments the example runs interactively.\n";
+}
+
+/// Parse a nonzero divisor that fits Integer.
+template <typename Integer>
+bool parse_divisor(const char* text, Integer& divisor)
+{
+    char* end = nullptr;
+    errno = 0;
+    if (is_signed<Integer>::value) {
+        long long value = strtoll(text, &end, 0);
+        divisor = Integer(value);
+        if (errno != 0 || value < numeric_limits<Integer>::min() || value > numeric_limits<Integer>::max()) {
+            return false;
+        }
+    }
+    else {
+        unsigned long long value = strtoull(text, &end, 0);
+        divisor = Integer(value);
+        if (errno != 0 || text[0] == '-' || value > numeric_limits<Integer>::max()) {
+            return false;
+        }
+    }
+    return *end == '\0' && divisor != 0;
+}
+
+template <typename Integer>
+int divide_file(const char* divisor_text, const char* input, const char* output,
+                const fast_division::stream_division_settings& settings)
+{
+    Integer divisor;
+    if (!parse_divisor(divisor_text, divisor)) {
+        cerr << "Invalid divisor " << divisor_text << "\n";
+        return 1;
+    }
+    fast_division::constant_divider<Integer> divider(divisor);
+    auto result = output != nullptr ? fast_division::divide_file(divider, input, output, settings)
+                                    : fast_division::divide_file_in_place(divider, input, settings);
+    if (result.io_error) {
+        cerr << "Cannot divide " << input << ": " << strerror(errno) << "\n";
+        return 1;
+    }
+    cerr << result.elements << " values divided by " << +divisor << "\n";
+    if (result.trailing_bytes != 0) {
+        cerr << result.trailing_bytes << " trailing bytes are not a whole value and were copied unchanged\n";
+        return 1;
+    }
+    return 0;
+}
+
+int file_division(int argc, char* argv[])
 {
+    vector<const char*> positional;
+    fast_division::stream_division_settings settings;
+    unique_ptr<fast_division::division_pool> pool;
+    for (int i = 1; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--block-size") == 0 && has_value) {
+            settings.block_bytes = size_t(strtoull(argv[++i], nullptr, 0));
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && has_value) {
+            pool.reset(new fast_division::division_pool(unsigned(strtoul(argv[++i], nullptr, 0))));
+            settings.pool = pool.get();
+        }
+        else if (argv[i][0] == '-' && argv[i][1] == '-') {
+            file_division_usage(argv[0]);
+            return 1;
+        }
+        else {
+            positional.push_back(argv[i]);
+        }
+    }
+    if (positional.size() != 3 && positional.size() != 4) {
+        file_division_usage(argv[0]);
+        return 1;
+    }
+    const string type = positional[0];
+    const char* output = positional.size() == 4 ? positional[3] : nullptr;
+    if (type == "uint8") return divide_file<uint8_t>(positional[1], positional[2], output, settings);
+    if (type == "int8") return divide_file<int8_t>(positional[1], positional[2], output, settings);
+    if (type == "uint16") return divide_file<uint16_t>(positional[1], positional[2], output, settings);
+    if (type == "int16") return divide_file<int16_t>(positional[1], positional[2], output, settings);
+    if (type == "uint32") return divide_file<uint32_t>(positional[1], positional[2], output, settings);
+    if (type == "int32") return divide_file<int32_t>(positional[1], positional[2], output, settings);
+    if (type == "uint64") return divide_file<uint64_t>(positional[1], positional[2], output, settings);
+    if (type == "int64") return divide_file<int64_t>(positional[1], positional[2], output, settings);
+    file_division_usage(argv[0]);
+    return 1;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1) {
+        return file_division(argc, argv);
+    }
     char choice;
-    cout << "Choose mode:\n 1) Unsigned division.\n 2) Signed division.\n 3) Unsigned division SIMD.\n";
+    cout << "Choose mode:\n 1) Unsigned division.\n 2) Signed division.\n 3) Unsigned division SIMD.\n 4) Unsigned bulk division.\n";
     while (cin >> choice) {
         switch (choice) {
         case '1':
@@ -101,10 +235,13 @@ int main()
         case '3':
             interactive_division_unsigned_simd();
             break;
+        case '4':
+            interactive_division_bulk();
+            break;
         default:
             cout << "Invalid option.\n";
         }
-        cout << "Choose mode:\n 1) Unsigned division.\n 2) Signed division.\n 3) Unsigned division SIMD.\n";
+        cout << "Choose mode:\n 1) Unsigned division.\n 2) Signed division.\n 3) Unsigned division SIMD.\n 4) Unsigned bulk division.\n";
     }
 
     return 0;
@@ -0,0 +1,284 @@
+/**
+ *  Fast Division Library
+ *  Created by Stefan Ivanov
+ *
+ *  Using ideas from
+ *  Division by Invariant Integers Using Multiplication (1994)
+ *  by Torbjörn Granlund, Peter L. Montgomery
+ */
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include <fast_division/division_policy.hpp>
+#include <fast_division/fast_division_simd.hpp>
+#include <fast_division/utility/associated_types.hpp>
+#include <fast_division/utility/high_multiplication.hpp>
+#include <fast_division/utility/log2i.hpp>
+
+namespace fast_division {
+
+    template <typename Integer, template <typename I, bool S> class DivisionPolicy>
+    class divider_table;
+
+    /// A divider that evaluates every divisor, including 1 and powers of two, with the same
+    /// instruction sequence and a single shift, so that it behaves identically in every lane of
+    /// a vector and never mispredicts when the divisor changes between calls.
+    ///
+    /// The unsigned quotient is ((((n - t) >> 1) + t) >> (l - 1)) with t = mulhi(m, n) and
+    /// l = ceil(log2(d)). Powers of two fall out of the general formula with m = 1. Only 1 does
+    /// not fit, as l - 1 would be negative, so its multiplier and shift clear the quotient and a
+    /// mask puts the input back in: the sequence ends in | (n & one_mask), which is 0 otherwise.
+    /// The signed quotient is that of constant_divider with the rounding correction done by
+    /// an arithmetic shift instead of a comparison.
+    template <typename Integer, template <typename I, bool S> class DivisionPolicy = promotion_policy,
+              bool Signed = std::is_signed<Integer>::value>
+    class branchfree_divider {
+    public:
+        constexpr static const auto word_size = sizeof(Integer) * 8;
+        using division_policy = DivisionPolicy<Integer, false>;
+        using value_type = Integer;
+
+        constexpr explicit branchfree_divider(Integer divisor)
+            : divisor_(divisor),
+              multiplier_(divisor == Integer(1) ? Integer(0) : division_policy::calculate_multiplier(divisor, log_ceil(divisor))),
+              shift_(divisor == Integer(1) ? Integer(word_size - 1) : Integer(log_ceil(divisor) - 1)),
+              one_mask_(divisor == Integer(1) ? Integer(~Integer(0)) : Integer(0))
+        {}
+
+        constexpr const Integer& divisor() const { return divisor_; }
+
+        constexpr Integer operator()(Integer input) const
+        {
+            return evaluate(input, multiplier_, shift_, one_mask_);
+        }
+
+        template <typename Simd, typename = std::enable_if_t<utility::is_simd<Simd>::value>>
+        Simd operator()(Simd input) const
+        {
+            static_assert(sizeof(Simd) == 0, "Division by a simd vector must use a specialization");
+            return input;
+        }
+
+        constexpr Integer remainder(Integer input) const
+        {
+            return Integer(input - Integer(operator()(input) * divisor_));
+        }
+
+        friend constexpr
+        bool operator== (const branchfree_divider& x, const branchfree_divider& y)
+        {
+            return x.divisor_ == y.divisor_;
+        }
+        friend constexpr
+        bool operator!= (const branchfree_divider& x, const branchfree_divider& y)
+        {
+            return x.divisor_ != y.divisor_;
+        }
+
+    private:
+        template <typename I, template <typename, bool> class P>
+        friend class divider_table;
+
+        /// The last constant of the sequence, kept under one name for divider_table.
+        constexpr Integer mask() const { return one_mask_; }
+
+        static constexpr Integer evaluate(Integer input, Integer multiplier, Integer shift, Integer one_mask)
+        {
+            Integer t = utility::high_mult(multiplier, input);
+            Integer q = Integer(Integer(Integer(Integer(input - t) >> 1) + t) >> shift);
+            return Integer(q | Integer(input & one_mask));
+        }
+
+        static constexpr Integer log_ceil(Integer divisor)
+        {
+            return Integer(utility::log2i(Integer(divisor - Integer(1))) + 1);
+        }
+
+        Integer divisor_;
+        Integer multiplier_;
+        Integer shift_;
+        Integer one_mask_;
+    };
+
+    template <typename Integer, template <typename I, bool S> class DivisionPolicy>
+    class branchfree_divider<Integer, DivisionPolicy, true> {
+    public:
+        constexpr static const auto word_size = sizeof(Integer) * 8;
+        using division_policy = DivisionPolicy<Integer, true>;
+        using value_type = Integer;
+        using u_type = std::make_unsigned_t<Integer>;
+
+        constexpr explicit branchfree_divider(Integer divisor)
+            : divisor_(divisor),
+              multiplier_(division_policy::calculate_multiplier(abs(divisor), log_ceil(abs(divisor)))),
+              shift_(Integer(log_ceil(abs(divisor)) - 1)),
+              sign_(divisor < 0 ? Integer(-1) : Integer(0))
+        {}
+
+        constexpr const Integer& divisor() const { return divisor_; }
+
+        constexpr Integer operator()(Integer input) const
+        {
+            return evaluate(input, multiplier_, shift_, sign_);
+        }
+
+        template <typename Simd, typename = std::enable_if_t<utility::is_simd<Simd>::value>>
+        Simd operator()(Simd input) const
+        {
+            static_assert(sizeof(Simd) == 0, "Division by a simd vector must use a specialization");
+            return input;
+        }
+
+        constexpr Integer remainder(Integer input) const
+        {
+            return Integer(input - Integer(operator()(input) * divisor_));
+        }
+
+        friend constexpr
+        bool operator== (const branchfree_divider& x, const branchfree_divider& y)
+        {
+            return x.divisor_ == y.divisor_;
+        }
+        friend constexpr
+        bool operator!= (const branchfree_divider& x, const branchfree_divider& y)
+        {
+            return x.divisor_ != y.divisor_;
+        }
+
+    private:
+        template <typename I, template <typename, bool> class P>
+        friend class divider_table;
+
+        constexpr Integer mask() const { return sign_; }
+
+        static constexpr Integer evaluate(Integer input, Integer multiplier, Integer shift, Integer sign)
+        {
+            // Wrapping unsigned arithmetic, as the sum overflows for the minimum divided by +-1.
+            u_type q = u_type(u_type(input) + u_type(utility::high_mult(multiplier, input)));
+            q = u_type(Integer(q) >> shift);
+            q = u_type(q - u_type(Integer(input >> (word_size - 1))));
+            return Integer(u_type(u_type(q ^ u_type(sign)) - u_type(sign)));
+        }
+
+        static constexpr u_type abs(Integer divisor)
+        {
+            return divisor < 0 ? u_type(u_type(0) - u_type(divisor)) : u_type(divisor);
+        }
+
+        /// The bit scan is undefined for zero, so a divisor of magnitude 1 gets l = 1.
+        static constexpr Integer log_ceil(u_type abs_divisor)
+        {
+            return abs_divisor == u_type(1) ? Integer(1) : Integer(utility::log2i(u_type(abs_divisor - u_type(1))) + 1);
+        }
+
+        Integer divisor_;
+        Integer multiplier_;
+        Integer shift_;
+        Integer sign_;
+    };
+
+    template <typename Integer, template <typename, bool> class DivisionPolicy, typename T>
+    inline constexpr
+    Integer operator/ (T&& divident, const branchfree_divider<Integer, DivisionPolicy>& divisor)
+    {
+        return divisor(std::forward<T>(divident));
+    }
+
+    template <typename Integer, template <typename, bool> class DivisionPolicy, typename T>
+    inline constexpr
+    Integer operator% (T&& divident, const branchfree_divider<Integer, DivisionPolicy>& divisor)
+    {
+        return divisor.remainder(std::forward<T>(divident));
+    }
+
+    /// Specializations for various simd types. The signed sequence is the one of the
+    /// constant_divider kernels, which is already uniform.
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_SSE41
+    __m128i branchfree_divider<uint32_t, promotion_policy>::operator()<> (__m128i input) const
+    {
+        return detail::divide_branchfree_epu32(input, multiplier_, shift_, one_mask_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX2
+    __m256i branchfree_divider<uint32_t, promotion_policy>::operator()<> (__m256i input) const
+    {
+        return detail::divide_branchfree_epu32(input, multiplier_, shift_, one_mask_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX512
+    __m512i branchfree_divider<uint32_t, promotion_policy>::operator()<> (__m512i input) const
+    {
+        return detail::divide_branchfree_epu32(input, multiplier_, shift_, one_mask_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_SSE41
+    __m128i branchfree_divider<int32_t, promotion_policy>::operator()<> (__m128i input) const
+    {
+        return detail::divide_epi32(input, multiplier_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX2
+    __m256i branchfree_divider<int32_t, promotion_policy>::operator()<> (__m256i input) const
+    {
+        return detail::divide_epi32(input, multiplier_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX512
+    __m512i branchfree_divider<int32_t, promotion_policy>::operator()<> (__m512i input) const
+    {
+        return detail::divide_epi32(input, multiplier_, shift_, sign_);
+    }
+
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_SSE41
+    __m128i branchfree_divider<uint32_t, decomposition_policy>::operator()<> (__m128i input) const
+    {
+        return detail::divide_branchfree_epu32(input, multiplier_, shift_, one_mask_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX2
+    __m256i branchfree_divider<uint32_t, decomposition_policy>::operator()<> (__m256i input) const
+    {
+        return detail::divide_branchfree_epu32(input, multiplier_, shift_, one_mask_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX512
+    __m512i branchfree_divider<uint32_t, decomposition_policy>::operator()<> (__m512i input) const
+    {
+        return detail::divide_branchfree_epu32(input, multiplier_, shift_, one_mask_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_SSE41
+    __m128i branchfree_divider<int32_t, decomposition_policy>::operator()<> (__m128i input) const
+    {
+        return detail::divide_epi32(input, multiplier_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX2
+    __m256i branchfree_divider<int32_t, decomposition_policy>::operator()<> (__m256i input) const
+    {
+        return detail::divide_epi32(input, multiplier_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX512
+    __m512i branchfree_divider<int32_t, decomposition_policy>::operator()<> (__m512i input) const
+    {
+        return detail::divide_epi32(input, multiplier_, shift_, sign_);
+    }
+
+}
@@ -0,0 +1,254 @@
+/**
+ *  Fast Division Library
+ *  Created by Stefan Ivanov
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include <immintrin.h>
+
+#include <fast_division/fast_division.hpp>
+#include <fast_division/fast_division_dispatch.hpp>
+#include <fast_division/division_policy.hpp>
+#include <fast_division/utility/cpu_features.hpp>
+#include <fast_division/utility/log2i.hpp>
+#include <fast_division/utility/wide_division.hpp>
+
+namespace fast_division {
+
+    namespace detail {
+
+        /// Policies whose dividers hold a multiplier and shifts. Both compute the same constants,
+        /// so the batch code below serves both. fastmod_policy stores a reciprocal instead.
+        template <template <typename, bool> class DivisionPolicy>
+        struct is_multiplier_policy : std::false_type {};
+
+        template <>
+        struct is_multiplier_policy<promotion_policy> : std::true_type {};
+
+        template <>
+        struct is_multiplier_policy<decomposition_policy> : std::true_type {};
+
+        /// The 32-bit multipliers are 1 + floor(n / d) for an n below 2^63 and a quotient below
+        /// 2^32, or one that is exact. Four of them are estimated at once by a double division: n and d convert exactly
+        /// and the quotient is correctly rounded, so its floor is never too small and at most one
+        /// too large, which a 64-bit multiplication detects.
+
+        /// floor(n / d) + 1 in the low halves of the 64-bit lanes.
+        inline FAST_DIVISION_TARGET_AVX2
+        __m128i multipliers_epu32(__m256d numerator, __m256i numerator_64, __m256d divisor, __m256i divisor_64)
+        {
+            // Adding 2^52 moves an integral double below 2^32 into the low half of its bits.
+            const __m256d magic = _mm256_set1_pd(4503599627370496.0);
+            __m256d estimate = _mm256_floor_pd(_mm256_div_pd(numerator, divisor));
+            __m256i q = _mm256_castpd_si256(_mm256_add_pd(estimate, magic));
+            __m256i too_large = _mm256_cmpgt_epi64(_mm256_mul_epu32(q, divisor_64), numerator_64);
+            __m256i m = _mm256_sub_epi64(_mm256_add_epi64(q, _mm256_set1_epi64x(1)), _mm256_and_si256(too_large, _mm256_set1_epi64x(1)));
+            return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(m, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6)));
+        }
+
+        /// floor(log2(x)) of x >= 1, from the exponent of its exact conversion to double. Both
+        /// are returned, the exponent in 32-bit lanes.
+        inline FAST_DIVISION_TARGET_AVX2
+        __m128i log2_epu32(__m128i x, __m256d& x_pd)
+        {
+            // Unsigned lanes convert as signed ones offset by 2^31.
+            __m256d biased = _mm256_cvtepi32_pd(_mm_xor_si128(x, _mm_set1_epi32(INT32_MIN)));
+            x_pd = _mm256_add_pd(biased, _mm256_set1_pd(2147483648.0));
+            __m256i exponent = _mm256_srli_epi64(_mm256_castpd_si256(x_pd), 52);
+            exponent = _mm256_permutevar8x32_epi32(exponent, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));
+            return _mm_sub_epi32(_mm256_castsi256_si128(exponent), _mm_set1_epi32(1023));
+        }
+
+        /// Constants of four unsigned dividers, as in constant_divider_base. With e = floor(log2(d))
+        /// a divisor that is not a power of two has l = e + 1, and the multiplier is
+        /// 1 + floor((2^l - d) * 2^32 / d), where 2^l - d < 2^31.
+        inline FAST_DIVISION_TARGET_AVX2
+        void constants_epu32(__m128i divisor, __m128i& multiplier, __m128i& shift_1, __m128i& shift_2)
+        {
+            const __m128i one = _mm_set1_epi32(1);
+            __m256d divisor_pd;
+            __m128i e = log2_epu32(divisor, divisor_pd);
+            __m128i power_of_two = _mm_cmpeq_epi32(_mm_and_si128(divisor, _mm_sub_epi32(divisor, one)), _mm_setzero_si128());
+            // 2^l wraps around to 0 when l == 32, which leaves 2^32 - d as it should.
+            __m128i high = _mm_sub_epi32(_mm_sllv_epi32(one, _mm_add_epi32(e, one)), divisor);
+            __m256d numerator = _mm256_mul_pd(_mm256_cvtepi32_pd(high), _mm256_set1_pd(4294967296.0));
+            __m256i numerator_64 = _mm256_slli_epi64(_mm256_cvtepu32_epi64(high), 32);
+            __m128i m = multipliers_epu32(numerator, numerator_64, divisor_pd, _mm256_cvtepu32_epi64(divisor));
+            // 1 and powers of two only shift by e, the multipliers computed for them are discarded.
+            multiplier = _mm_andnot_si128(power_of_two, m);
+            shift_1 = _mm_andnot_si128(power_of_two, one);
+            shift_2 = e;
+        }
+
+        /// Constants of four signed dividers, as in constant_divider_base. With a = |d| and
+        /// l = ceil(log2(a)), or 1 for a == 1, the multiplier is the low half of
+        /// 1 + floor(2^(31 + l) / a), a quotient in [2^31, 2^32].
+        inline FAST_DIVISION_TARGET_AVX2
+        void constants_epi32(__m128i divisor, __m128i& multiplier, __m128i& shift, __m128i& sign)
+        {
+            const __m128i one = _mm_set1_epi32(1);
+            // The magnitude of the minimum is 2^31, which is right as an unsigned lane.
+            __m128i magnitude = _mm_abs_epi32(divisor);
+            __m256d magnitude_pd;
+            __m128i e = log2_epu32(magnitude, magnitude_pd);
+            __m128i power_of_two = _mm_cmpeq_epi32(_mm_and_si128(magnitude, _mm_sub_epi32(magnitude, one)), _mm_setzero_si128());
+            // l - 1 is e - 1 for powers of two except 1, and e otherwise.
+            shift = _mm_max_epi32(_mm_add_epi32(e, power_of_two), _mm_setzero_si128());
+            // 2^(31 + l), as an integer and as a double built from its exponent.
+            __m256i exponent = _mm256_cvtepu32_epi64(_mm_add_epi32(shift, _mm_set1_epi32(32)));
+            __m256i numerator_64 = _mm256_sllv_epi64(_mm256_set1_epi64x(1), exponent);
+            __m256d numerator = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(exponent, _mm256_set1_epi64x(1023)), 52));
+            // For a == 1 the quotient 2^32 is exact and its low half 0 gives the multiplier 1.
+            multiplier = multipliers_epu32(numerator, numerator_64, magnitude_pd, _mm256_cvtepu32_epi64(magnitude));
+            sign = _mm_srai_epi32(divisor, 31);
+        }
+
+        inline FAST_DIVISION_TARGET_AVX2
+        void constants_avx2(const uint32_t* divisors, uint32_t* c_1, uint32_t* c_2, uint32_t* c_3)
+        {
+            __m128i m, s_1, s_2;
+            constants_epu32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(divisors)), m, s_1, s_2);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(c_1), m);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(c_2), s_1);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(c_3), s_2);
+        }
+
+        inline FAST_DIVISION_TARGET_AVX2
+        void constants_avx2(const int32_t* divisors, int32_t* c_1, int32_t* c_2, int32_t* c_3)
+        {
+            __m128i m, s, sign;
+            constants_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(divisors)), m, s, sign);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(c_1), m);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(c_2), s);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(c_3), sign);
+        }
+
+        /// Constants of 64-bit dividers with the multiplier from a single native double-word
+        /// division, instead of a 128-bit division or the four half-word steps.
+
+        inline
+        void constants_native(uint64_t divisor, uint64_t& multiplier, uint64_t& shift_1, uint64_t& shift_2)
+        {
+            if ((divisor & (divisor - 1)) == 0) {
+                multiplier = shift_1 = 0;
+                shift_2 = utility::log2i(divisor);
+                return;
+            }
+            uint64_t l = utility::log2i(divisor - 1) + 1;
+            uint64_t high = (l == 64 ? uint64_t(0) : uint64_t(1) << l) - divisor;
+            multiplier = 1 + utility::divide_double_word_native(high, 0, divisor);
+            shift_1 = 1;
+            shift_2 = l - 1;
+        }
+
+        inline
+        void constants_native(int64_t divisor, int64_t& multiplier, int64_t& shift, int64_t& sign)
+        {
+            uint64_t magnitude = divisor < 0 ? uint64_t(0) - uint64_t(divisor) : uint64_t(divisor);
+            uint64_t l = magnitude == 1 ? 1 : utility::log2i(magnitude - 1) + 1;
+            multiplier = magnitude == 1 ? 1 : int64_t(1 + utility::divide_double_word_native(uint64_t(1) << (l - 1), 0, magnitude));
+            shift = int64_t(l - 1);
+            sign = divisor < 0 ? -1 : 0;
+        }
+
+        /// Selects the batch code by word size, 0 where dividers are constructed one by one.
+        template <typename Integer, template <typename, bool> class DivisionPolicy>
+        using batch_constants = std::integral_constant<std::size_t,
+            is_multiplier_policy<DivisionPolicy>::value && sizeof(Integer) >= 4 ? sizeof(Integer) : 0>;
+
+        template <typename Integer, template <typename, bool> class DivisionPolicy, std::size_t Size>
+        inline
+        void append_dividers(const Integer* divisors, std::size_t size,
+                             std::vector<constant_divider<Integer, DivisionPolicy>>& output,
+                             std::integral_constant<std::size_t, Size>)
+        {
+            for (std::size_t i = 0; i != size; ++i) {
+                output.emplace_back(divisors[i]);
+            }
+        }
+
+        template <typename Integer, template <typename, bool> class DivisionPolicy>
+        inline FAST_DIVISION_TARGET_AVX2
+        void append_dividers_avx2(const Integer* divisors, std::size_t size,
+                                  std::vector<constant_divider<Integer, DivisionPolicy>>& output)
+        {
+            using word = std::conditional_t<std::is_signed<Integer>::value, int32_t, uint32_t>;
+            word c_1[4], c_2[4], c_3[4];
+            std::size_t i = 0;
+            for (; i + 4 <= size; i += 4) {
+                constants_avx2(reinterpret_cast<const word*>(divisors + i), c_1, c_2, c_3);
+                for (std::size_t j = 0; j != 4; ++j) {
+                    output.emplace_back(precomputed, divisors[i + j], Integer(c_1[j]), Integer(c_2[j]), Integer(c_3[j]));
+                }
+            }
+            for (; i != size; ++i) {
+                output.emplace_back(divisors[i]);
+            }
+        }
+
+        template <typename Integer, template <typename, bool> class DivisionPolicy>
+        inline
+        void append_dividers(const Integer* divisors, std::size_t size,
+                             std::vector<constant_divider<Integer, DivisionPolicy>>& output,
+                             std::integral_constant<std::size_t, 4>)
+        {
+            if (active_simd_level() >= simd_level::avx2) {
+                append_dividers_avx2(divisors, size, output);
+            }
+            else {
+                append_dividers(divisors, size, output, std::integral_constant<std::size_t, 0>{});
+            }
+        }
+
+        template <typename Integer, template <typename, bool> class DivisionPolicy>
+        inline
+        void append_dividers(const Integer* divisors, std::size_t size,
+                             std::vector<constant_divider<Integer, DivisionPolicy>>& output,
+                             std::integral_constant<std::size_t, 8>)
+        {
+            using word = std::conditional_t<std::is_signed<Integer>::value, int64_t, uint64_t>;
+            for (std::size_t i = 0; i != size; ++i) {
+                word c_1 = 0, c_2 = 0, c_3 = 0;
+                constants_native(word(divisors[i]), c_1, c_2, c_3);
+                output.emplace_back(precomputed, divisors[i], Integer(c_1), Integer(c_2), Integer(c_3));
+            }
+        }
+
+    }
+
+    /// Build the dividers of many runtime divisors at once, e.g. of every partition or column
+    /// when a query starts, and append them to output. The result is the same as constructing
+    /// them one by one, only faster: 32-bit multipliers are computed four at a time with AVX2
+    /// and 64-bit ones with a single hardware division each. Other types and fastmod_policy
+    /// are constructed one by one.
+    template <typename Integer, template <typename, bool> class DivisionPolicy>
+    inline
+    void append_dividers(const Integer* divisors, std::size_t size,
+                         std::vector<constant_divider<Integer, DivisionPolicy>>& output)
+    {
+        detail::append_dividers(divisors, size, output, detail::batch_constants<Integer, DivisionPolicy>{});
+    }
+
+    template <template <typename, bool> class DivisionPolicy = promotion_policy, typename Integer>
+    inline
+    std::vector<constant_divider<Integer, DivisionPolicy>> make_dividers(const Integer* divisors, std::size_t size)
+    {
+        std::vector<constant_divider<Integer, DivisionPolicy>> dividers;
+        dividers.reserve(size);
+        append_dividers(divisors, size, dividers);
+        return dividers;
+    }
+
+    /// The same for a contiguous range (anything with data() and size()).
+    template <template <typename, bool> class DivisionPolicy = promotion_policy, typename Range>
+    inline
+    auto make_dividers(const Range& divisors)
+    {
+        return make_dividers<DivisionPolicy>(divisors.data(), divisors.size());
+    }
+
+}
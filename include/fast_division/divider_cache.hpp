@@ -0,0 +1,266 @@
+/**
+ *  Fast Division Library
+ *  Created by Stefan Ivanov
+ */
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+#include <fast_division/fast_division.hpp>
+
+namespace fast_division {
+
+    /// Counters of a divider_cache, summed over all threads.
+    struct cache_statistics {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t insertions;
+        uint64_t evictions;
+    };
+
+    /// A bounded cache of prebuilt dividers keyed by divisor, for workloads where the same runtime
+    /// divisors recur and construction (a wide division) would otherwise be paid every time.
+    ///
+    /// The cache is 4-way set associative. Lookups never block: every slot is guarded by a sequence
+    /// lock, so readers copy the divider out and retry if a writer got in between. Dividers are
+    /// returned by value rather than by reference, because an evicted slot is reused in place and a
+    /// reference could change under the caller; a divider is only a few words, so the copy is cheap.
+    /// Inserting into a slot that another thread is writing is skipped instead of waiting.
+    /// Eviction uses the CLOCK approximation of LRU within a set.
+    template <typename Integer, template <typename I, bool S> class DivisionPolicy = promotion_policy>
+    class divider_cache {
+    public:
+        using divider_type = constant_divider<Integer, DivisionPolicy>;
+        using value_type = Integer;
+        constexpr static const std::size_t ways = 4;
+
+        static_assert(std::is_trivially_copyable<divider_type>::value, "Dividers are copied through their bytes");
+
+        /// Capacity is rounded up to a power of two and at least one set.
+        explicit divider_cache(std::size_t capacity)
+            : num_sets_(round_up_sets(capacity)),
+              slots_(new slot[num_sets_ * ways]),
+              hands_(new std::atomic<uint8_t>[num_sets_])
+        {
+            for (std::size_t i = 0; i != num_sets_; ++i) {
+                hands_[i].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        divider_cache(const divider_cache&) = delete;
+        divider_cache& operator=(const divider_cache&) = delete;
+
+        std::size_t capacity() const { return num_sets_ * ways; }
+
+        /// The divider for divisor, built and inserted on a miss.
+        divider_type get(Integer divisor)
+        {
+            assert(divisor != 0);
+            slot* set = set_of(divisor);
+            payload_type words;
+            for (std::size_t way = 0; way != ways; ++way) {
+                if (set[way].read(divisor, words)) {
+                    count(&counters::hits);
+                    return from_payload(words);
+                }
+            }
+            count(&counters::misses);
+            divider_type divider(divisor);
+            insert(set, divider);
+            return divider;
+        }
+
+        /// Whether divisor is cached, without touching the counters or the eviction state.
+        bool contains(Integer divisor) const
+        {
+            assert(divisor != 0);
+            const slot* set = set_of(divisor);
+            payload_type words;
+            for (std::size_t way = 0; way != ways; ++way) {
+                if (set[way].peek(divisor, words)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        cache_statistics statistics() const
+        {
+            cache_statistics sum = { 0, 0, 0, 0 };
+            for (auto& stripe : counters_) {
+                sum.hits += stripe.hits.load(std::memory_order_relaxed);
+                sum.misses += stripe.misses.load(std::memory_order_relaxed);
+                sum.insertions += stripe.insertions.load(std::memory_order_relaxed);
+                sum.evictions += stripe.evictions.load(std::memory_order_relaxed);
+            }
+            return sum;
+        }
+
+    private:
+        constexpr static const std::size_t payload_words = (sizeof(divider_type) + 7) / 8;
+        constexpr static const std::size_t num_stripes = 16;
+
+        struct payload_type {
+            uint64_t words[payload_words];
+        };
+
+        static divider_type from_payload(const payload_type& payload)
+        {
+            // Dividers have no default constructor, so the bytes go through raw storage.
+            std::aligned_storage_t<sizeof(divider_type), alignof(divider_type)> storage;
+            std::memcpy(&storage, payload.words, sizeof(divider_type));
+            return *reinterpret_cast<const divider_type*>(&storage);
+        }
+
+        /// A slot under a sequence lock. The sequence is odd while a writer owns the slot, and the
+        /// key and payload are atomics so that racing reads are well defined. A zero key is empty.
+        struct slot {
+            std::atomic<uint32_t> sequence{0};
+            std::atomic<Integer> key{Integer(0)};
+            std::atomic<uint8_t> referenced{0};
+            std::atomic<uint64_t> payload[payload_words];
+
+            slot()
+            {
+                for (auto& word : payload) {
+                    word.store(0, std::memory_order_relaxed);
+                }
+            }
+
+            bool peek(Integer divisor, payload_type& result) const
+            {
+                for (int attempt = 0; attempt != 4; ++attempt) {
+                    uint32_t before = sequence.load(std::memory_order_acquire);
+                    if (before & 1u) {
+                        return false;
+                    }
+                    if (key.load(std::memory_order_relaxed) != divisor) {
+                        return false;
+                    }
+                    for (std::size_t i = 0; i != payload_words; ++i) {
+                        result.words[i] = payload[i].load(std::memory_order_relaxed);
+                    }
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (sequence.load(std::memory_order_relaxed) == before) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            bool read(Integer divisor, payload_type& result)
+            {
+                if (!peek(divisor, result)) {
+                    return false;
+                }
+                // Avoid writing the shared line when the bit is already set.
+                if (referenced.load(std::memory_order_relaxed) == 0) {
+                    referenced.store(1, std::memory_order_relaxed);
+                }
+                return true;
+            }
+
+            /// Returns whether the slot was written and whether it held another divisor.
+            bool write(const divider_type& divider, bool& evicted)
+            {
+                uint32_t before = sequence.load(std::memory_order_relaxed);
+                if ((before & 1u) || !sequence.compare_exchange_strong(before, before + 1, std::memory_order_acquire)) {
+                    return false;
+                }
+                std::atomic_thread_fence(std::memory_order_release);
+                evicted = key.load(std::memory_order_relaxed) != Integer(0);
+                uint64_t words[payload_words] = {};
+                std::memcpy(words, &divider, sizeof(divider_type));
+                key.store(divider.divisor(), std::memory_order_relaxed);
+                for (std::size_t i = 0; i != payload_words; ++i) {
+                    payload[i].store(words[i], std::memory_order_relaxed);
+                }
+                referenced.store(0, std::memory_order_relaxed);
+                sequence.store(before + 2, std::memory_order_release);
+                return true;
+            }
+        };
+
+        /// Counters are striped over cache lines by thread so that hits do not contend.
+        struct alignas(64) counters {
+            std::atomic<uint64_t> hits{0};
+            std::atomic<uint64_t> misses{0};
+            std::atomic<uint64_t> insertions{0};
+            std::atomic<uint64_t> evictions{0};
+        };
+
+        static std::size_t round_up_sets(std::size_t capacity)
+        {
+            std::size_t sets = 1;
+            while (sets * ways < capacity) {
+                sets *= 2;
+            }
+            return sets;
+        }
+
+        slot* set_of(Integer divisor) const
+        {
+            // Fibonacci hashing spreads nearby divisors over the sets.
+            uint64_t hash = uint64_t(std::make_unsigned_t<Integer>(divisor)) * 0x9E3779B97F4A7C15ull;
+            return &slots_[((hash >> 32) & (num_sets_ - 1)) * ways];
+        }
+
+        void insert(slot* set, const divider_type& divider)
+        {
+            std::size_t set_index = std::size_t(set - slots_.get()) / ways;
+            // Another thread may have inserted the same divisor meanwhile. Otherwise prefer an
+            // empty way, and failing that advance the clock hand past recently used ways.
+            std::size_t victim = ways;
+            for (std::size_t way = 0; way != ways; ++way) {
+                Integer key = set[way].key.load(std::memory_order_relaxed);
+                if (key == divider.divisor()) {
+                    return;
+                }
+                if (key == Integer(0) && victim == ways) {
+                    victim = way;
+                }
+            }
+            if (victim == ways) {
+                uint8_t hand = hands_[set_index].load(std::memory_order_relaxed);
+                for (std::size_t step = 0; step != 2 * ways; ++step) {
+                    std::size_t way = (hand + step) % ways;
+                    if (set[way].referenced.exchange(0, std::memory_order_relaxed) == 0) {
+                        victim = way;
+                        break;
+                    }
+                }
+                if (victim == ways) {
+                    victim = hand % ways;
+                }
+                hands_[set_index].store(uint8_t((victim + 1) % ways), std::memory_order_relaxed);
+            }
+            bool evicted = false;
+            if (set[victim].write(divider, evicted)) {
+                count(&counters::insertions);
+                if (evicted) {
+                    count(&counters::evictions);
+                }
+            }
+        }
+
+        void count(std::atomic<uint64_t> counters::* counter)
+        {
+            static thread_local const std::size_t stripe = std::hash<std::thread::id>{}(std::this_thread::get_id()) % num_stripes;
+            (counters_[stripe].*counter).fetch_add(1, std::memory_order_relaxed);
+        }
+
+        std::size_t num_sets_;
+        std::unique_ptr<slot[]> slots_;
+        std::unique_ptr<std::atomic<uint8_t>[]> hands_;
+        counters counters_[num_stripes];
+    };
+
+}
@@ -0,0 +1,279 @@
+/**
+ *  Fast Division Library
+ *  Created by Stefan Ivanov
+ */
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+#include <immintrin.h>
+
+#include <fast_division/branchfree_divider.hpp>
+#include <fast_division/division_policy.hpp>
+#include <fast_division/fast_division_dispatch.hpp>
+#include <fast_division/fast_division_simd.hpp>
+#include <fast_division/utility/associated_types.hpp>
+#include <fast_division/utility/cpu_features.hpp>
+
+FAST_DIVISION_AVX512_WARNINGS_PUSH
+
+namespace fast_division {
+
+    namespace detail {
+
+        /// The per-lane kernel of a table: branch-free unsigned or signed division.
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i divide_lanes(__m256i input, __m256i multiplier, __m256i shift, __m256i mask, std::false_type)
+        {
+            return divide_branchfree_epu32(input, multiplier, shift, mask);
+        }
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i divide_lanes(__m256i input, __m256i multiplier, __m256i shift, __m256i mask, std::true_type)
+        {
+            return divide_epi32(input, multiplier, shift, mask);
+        }
+
+        inline FAST_DIVISION_TARGET_AVX512
+        __m512i divide_lanes(__m512i input, __m512i multiplier, __m512i shift, __m512i mask, std::false_type)
+        {
+            return divide_branchfree_epu32(input, multiplier, shift, mask);
+        }
+
+        inline FAST_DIVISION_TARGET_AVX512
+        __m512i divide_lanes(__m512i input, __m512i multiplier, __m512i shift, __m512i mask, std::true_type)
+        {
+            return divide_epi32(input, multiplier, shift, mask);
+        }
+
+        /// Bulk kernels over the columns of a table of 32-bit dividers. The element-wise ones load
+        /// the constants of consecutive dividers, the indexed ones gather them. Tails are scalar.
+
+        template <typename Table>
+        inline FAST_DIVISION_TARGET_AVX2
+        void divide_columns_avx2(const Table& table, const typename Table::value_type* input,
+                                 typename Table::value_type* output, std::size_t size)
+        {
+            using is_signed = std::is_signed<typename Table::value_type>;
+            std::size_t i = 0;
+            for (; i + 8 <= size; i += 8) {
+                __m256i n = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+                __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(table.multipliers() + i));
+                __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(table.shifts() + i));
+                __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(table.masks() + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), divide_lanes(n, m, s, k, is_signed{}));
+            }
+            for (; i != size; ++i) {
+                output[i] = table.divide(i, input[i]);
+            }
+        }
+
+        template <typename Table>
+        inline FAST_DIVISION_TARGET_AVX2
+        void divide_indexed_avx2(const Table& table, const typename Table::value_type* input,
+                                 const uint32_t* indices, typename Table::value_type* output, std::size_t size)
+        {
+            using is_signed = std::is_signed<typename Table::value_type>;
+            const int* multipliers = reinterpret_cast<const int*>(table.multipliers());
+            const int* shifts = reinterpret_cast<const int*>(table.shifts());
+            const int* masks = reinterpret_cast<const int*>(table.masks());
+            std::size_t i = 0;
+            for (; i + 8 <= size; i += 8) {
+                __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+                __m256i n = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+                __m256i m = _mm256_i32gather_epi32(multipliers, index, 4);
+                __m256i s = _mm256_i32gather_epi32(shifts, index, 4);
+                __m256i k = _mm256_i32gather_epi32(masks, index, 4);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), divide_lanes(n, m, s, k, is_signed{}));
+            }
+            for (; i != size; ++i) {
+                output[i] = table.divide(indices[i], input[i]);
+            }
+        }
+
+        template <typename Table>
+        inline FAST_DIVISION_TARGET_AVX512
+        void divide_columns_avx512(const Table& table, const typename Table::value_type* input,
+                                   typename Table::value_type* output, std::size_t size)
+        {
+            using is_signed = std::is_signed<typename Table::value_type>;
+            std::size_t i = 0;
+            for (; i + 16 <= size; i += 16) {
+                __m512i n = _mm512_loadu_si512(input + i);
+                __m512i m = _mm512_loadu_si512(table.multipliers() + i);
+                __m512i s = _mm512_loadu_si512(table.shifts() + i);
+                __m512i k = _mm512_loadu_si512(table.masks() + i);
+                _mm512_storeu_si512(output + i, divide_lanes(n, m, s, k, is_signed{}));
+            }
+            for (; i != size; ++i) {
+                output[i] = table.divide(i, input[i]);
+            }
+        }
+
+        template <typename Table>
+        inline FAST_DIVISION_TARGET_AVX512
+        void divide_indexed_avx512(const Table& table, const typename Table::value_type* input,
+                                   const uint32_t* indices, typename Table::value_type* output, std::size_t size)
+        {
+            using is_signed = std::is_signed<typename Table::value_type>;
+            std::size_t i = 0;
+            for (; i + 16 <= size; i += 16) {
+                __m512i index = _mm512_loadu_si512(indices + i);
+                __m512i n = _mm512_loadu_si512(input + i);
+                __m512i m = _mm512_i32gather_epi32(index, table.multipliers(), 4);
+                __m512i s = _mm512_i32gather_epi32(index, table.shifts(), 4);
+                __m512i k = _mm512_i32gather_epi32(index, table.masks(), 4);
+                _mm512_storeu_si512(output + i, divide_lanes(n, m, s, k, is_signed{}));
+            }
+            for (; i != size; ++i) {
+                output[i] = table.divide(indices[i], input[i]);
+            }
+        }
+
+    }
+
+    /// Many dividers stored as a structure of arrays, for dividing element i by divisor i or by
+    /// divisor indices[i], e.g. sums by counts that are reused over many passes. The constants
+    /// are those of branchfree_divider, so every lane runs the same sequence with its own
+    /// multiplier, shift and mask. Bulk division of 32-bit integers uses per-lane variable shifts
+    /// and, for indexed division, gathers, which need AVX2; other types and older processors use
+    /// a scalar loop over the same arrays.
+    template <typename Integer, template <typename I, bool S> class DivisionPolicy = promotion_policy>
+    class divider_table {
+    public:
+        using value_type = Integer;
+        using divider_type = branchfree_divider<Integer, DivisionPolicy>;
+
+        divider_table() = default;
+
+        divider_table(const Integer* divisors, std::size_t size)
+        {
+            reserve(size);
+            for (std::size_t i = 0; i != size; ++i) {
+                push_back(divisors[i]);
+            }
+        }
+
+        divider_table(std::initializer_list<Integer> divisors)
+            : divider_table(divisors.begin(), divisors.size())
+        {}
+
+        void reserve(std::size_t size)
+        {
+            divisors_.reserve(size);
+            multipliers_.reserve(size);
+            shifts_.reserve(size);
+            masks_.reserve(size);
+        }
+
+        void push_back(Integer divisor)
+        {
+            const divider_type divider(divisor);
+            divisors_.push_back(divisor);
+            multipliers_.push_back(divider.multiplier_);
+            shifts_.push_back(divider.shift_);
+            masks_.push_back(divider.mask());
+        }
+
+        /// Replace the divisor at index.
+        void assign(std::size_t index, Integer divisor)
+        {
+            assert(index < size());
+            const divider_type divider(divisor);
+            divisors_[index] = divisor;
+            multipliers_[index] = divider.multiplier_;
+            shifts_[index] = divider.shift_;
+            masks_[index] = divider.mask();
+        }
+
+        std::size_t size() const { return divisors_.size(); }
+
+        Integer divisor(std::size_t index) const { return divisors_[index]; }
+
+        divider_type divider(std::size_t index) const { return divider_type(divisors_[index]); }
+
+        /// input / divisor(index).
+        Integer divide(std::size_t index, Integer input) const
+        {
+            return divider_type::evaluate(input, multipliers_[index], shifts_[index], masks_[index]);
+        }
+
+        /// output[i] = input[i] / divisor(i) for the first size elements, size <= size().
+        void divide(const Integer* input, Integer* output, std::size_t size) const
+        {
+            assert(size <= this->size());
+            divide(input, output, size, has_lane_kernels{});
+        }
+
+        /// output[i] = input[i] / divisor(indices[i]). Every index must be less than size().
+        void divide_indexed(const Integer* input, const uint32_t* indices, Integer* output, std::size_t size) const
+        {
+            divide_indexed(input, indices, output, size, has_lane_kernels{});
+        }
+
+        /// The columns, for custom kernels.
+        const Integer* multipliers() const { return multipliers_.data(); }
+        const Integer* shifts() const { return shifts_.data(); }
+        const Integer* masks() const { return masks_.data(); }
+
+    private:
+        using has_lane_kernels = std::integral_constant<bool, utility::is_one_of<Integer, uint32_t, int32_t>::value>;
+
+        void divide(const Integer* input, Integer* output, std::size_t size, std::false_type) const
+        {
+            for (std::size_t i = 0; i != size; ++i) {
+                output[i] = divide(i, input[i]);
+            }
+        }
+
+        void divide(const Integer* input, Integer* output, std::size_t size, std::true_type) const
+        {
+            switch (active_simd_level()) {
+            case simd_level::avx512:
+                detail::divide_columns_avx512(*this, input, output, size);
+                break;
+            case simd_level::avx2:
+                detail::divide_columns_avx2(*this, input, output, size);
+                break;
+            default:
+                divide(input, output, size, std::false_type{});
+            }
+        }
+
+        void divide_indexed(const Integer* input, const uint32_t* indices, Integer* output, std::size_t size,
+                            std::false_type) const
+        {
+            for (std::size_t i = 0; i != size; ++i) {
+                output[i] = divide(indices[i], input[i]);
+            }
+        }
+
+        void divide_indexed(const Integer* input, const uint32_t* indices, Integer* output, std::size_t size,
+                            std::true_type) const
+        {
+            switch (active_simd_level()) {
+            case simd_level::avx512:
+                detail::divide_indexed_avx512(*this, input, indices, output, size);
+                break;
+            case simd_level::avx2:
+                detail::divide_indexed_avx2(*this, input, indices, output, size);
+                break;
+            default:
+                divide_indexed(input, indices, output, size, std::false_type{});
+            }
+        }
+
+        std::vector<Integer> divisors_;
+        std::vector<Integer> multipliers_;
+        std::vector<Integer> shifts_;
+        std::vector<Integer> masks_;
+    };
+
+}
+
+FAST_DIVISION_AVX512_WARNINGS_POP
@@ -9,7 +9,10 @@
 #pragma once
 
 #include <limits>
+#include <type_traits>
+
 #include <fast_division/utility/associated_types.hpp>
+#include <fast_division/utility/wide_division.hpp>
 
 namespace fast_division {
     
@@ -18,7 +21,7 @@ namespace fast_division {
         constexpr static auto word_size = 8*sizeof(Integer);
         using p_type = utility::promotion_t<Integer>;
         
-        static
+        constexpr static
         Integer calculate_multiplier(Integer divisor, Integer log_ceil)
         {
             return Integer(1) + Integer(((p_type(1) << word_size) * ((p_type(1) << log_ceil) - divisor)) / divisor);
@@ -31,7 +34,7 @@ namespace fast_division {
         constexpr static auto word_size = 8*sizeof(Integer);
         using p_type = utility::promotion_t<Integer>;
         
-        static
+        constexpr static
         Integer calculate_multiplier(Integer abs_divisor, Integer log_ceil)
         {
             return Integer(1) + Integer((p_type(1) << (word_size + log_ceil - 1)) / abs_divisor - (p_type(1) << word_size));
@@ -40,37 +43,62 @@ namespace fast_division {
     };
 
 
+    /// Computes the multiplier without a wider integer type by decomposing the double-word
+    /// division into half-word steps. This is the policy to use for 64-bit types on
+    /// compilers without a 128-bit integer.
+
     template <typename Integer, bool Signed>
     struct decomposition_policy {
         constexpr static auto word_size = 8*sizeof(Integer);
 
-        static
+        constexpr static
         Integer calculate_multiplier(Integer divisor, Integer log_ceil)
         {
-            constexpr auto max = std::numeric_limits<Integer>::max();
-            auto q_1 = max / divisor;
-            auto r_1 = max % divisor;
-            auto inter = max == log_ceil ? (max - divisor + Integer(1)) : ((Integer(1) << log_ceil) - divisor);
-            auto q_2 = inter / divisor;
-            auto r_2 = inter % divisor;
-            return Integer(1) + q_1 * inter + q_2*(r_1 + Integer(1)) + (r_1 * r_2) / divisor;
+            // 2^l - d, which wraps around to 2^N - d when l == N.
+            Integer high = Integer((log_ceil == word_size ? Integer(0) : Integer(Integer(1) << log_ceil)) - divisor);
+            return Integer(Integer(1) + utility::divide_double_word(high, Integer(0), divisor));
         }
     };
 
     template <typename Integer>
     struct decomposition_policy<Integer, true> {
         constexpr static auto word_size = 8*sizeof(Integer);
+        using u_type = std::make_unsigned_t<Integer>;
 
-        static
-        Integer calculate_multiplier(Integer divisor, Integer log_ceil)
+        constexpr static
+        Integer calculate_multiplier(Integer abs_divisor, Integer log_ceil)
+        {
+            // The quotient 2^(N + l - 1) / d lies in [2^(N-1), 2^N], so subtracting 2^N
+            // amounts to truncating it to a word. Only d == 1 reaches the upper bound.
+            u_type divisor = u_type(abs_divisor);
+            if (divisor == u_type(1)) {
+                return Integer(1);
+            }
+            u_type high = u_type(u_type(1) << (log_ceil - 1));
+            return Integer(u_type(u_type(1) + utility::divide_double_word(high, u_type(0), divisor)));
+        }
+    };
+
+    /// The "fastmod" scheme of Lemire, Kaser and Kurz, Faster Remainder by Direct Computation (2019).
+    /// Instead of a multiplier and shifts, the divider stores the 2N-bit fraction c = ceil(2^2N / d).
+    /// The quotient is the high half of c * n and the remainder is the high half of
+    /// (c * n mod 2^2N) * d, so the remainder does not need the quotient. Since the reciprocal
+    /// is twice the width of the operands, this policy is limited to types up to 32 bits.
+    /// constant_divider_base is specialized for it, as the evaluation sequence differs.
+
+    template <typename Integer, bool Signed>
+    struct fastmod_policy {
+        static_assert(sizeof(Integer) <= 4, "fastmod_policy needs a reciprocal twice the width of the operands");
+
+        constexpr static auto word_size = 8*sizeof(Integer);
+        using u_type = std::make_unsigned_t<Integer>;
+        using reciprocal_type = utility::promotion_t<u_type>;
+
+        /// ceil(2^2N / d) modulo 2^2N, which is 0 for d == 1.
+        constexpr static
+        reciprocal_type calculate_reciprocal(u_type abs_divisor)
         {
-            constexpr auto max = std::numeric_limits<Integer>::max();
-            auto q_1 = max / divisor;
-            auto r_1 = max % divisor;
-            auto inter = max == log_ceil ? (max - divisor + Integer(1)) : ((Integer(1) << log_ceil) - divisor);
-            auto q_2 = inter / divisor;
-            auto r_2 = inter % divisor;
-            return Integer(1) + q_1 * inter + q_2*(r_1 + Integer(1)) + (r_1 * r_2) / divisor;
+            return reciprocal_type(std::numeric_limits<reciprocal_type>::max() / abs_divisor + reciprocal_type(1));
         }
     };
 
@@ -0,0 +1,220 @@
+/**
+ *  Fast Division Library
+ *  Created by Stefan Ivanov
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <fast_division/utility/associated_types.hpp>
+#include <fast_division/utility/cpu_features.hpp>
+
+namespace fast_division {
+
+    /// The class of a divisor: 1 (or -1), a power of two (or its negation) and everything else.
+    /// For the unsigned multiplier bases these are also the three sets of constants, no multiplier
+    /// and no shift, a shift only, and a multiplier with the add step.
+    enum class divider_algorithm : int {
+        identity = 0,
+        power_of_two = 1,
+        multiply = 2
+    };
+
+    constexpr const char* algorithm_name(divider_algorithm algorithm)
+    {
+        return algorithm == divider_algorithm::identity ? "identity" :
+               algorithm == divider_algorithm::power_of_two ? "power_of_two" : "multiply";
+    }
+
+    template <typename Integer>
+    constexpr divider_algorithm classify_divisor(Integer divisor)
+    {
+        using u_type = std::make_unsigned_t<Integer>;
+        const u_type magnitude = divisor < Integer(0) ? u_type(u_type(0) - u_type(divisor)) : u_type(divisor);
+        return magnitude == u_type(1) ? divider_algorithm::identity :
+               (magnitude & u_type(magnitude - u_type(1))) == u_type(0) ? divider_algorithm::power_of_two :
+               divider_algorithm::multiply;
+    }
+
+    /// Whether divisions are counted, i.e. whether FAST_DIVISION_STATISTICS was defined.
+#if defined(FAST_DIVISION_STATISTICS)
+    constexpr bool statistics_enabled = true;
+#else
+    constexpr bool statistics_enabled = false;
+#endif
+
+    /// Divisions by constant_divider per divisor class and per SIMD level, summed over all
+    /// threads. A vector counts as one division per lane, and bulk division counts under the
+    /// level it dispatched to, including its scalar head and tail.
+    struct division_statistics {
+        constexpr static const std::size_t num_algorithms = 3;
+        constexpr static const std::size_t num_levels = 4;
+
+        uint64_t divisions[num_algorithms][num_levels];
+
+        uint64_t count(divider_algorithm algorithm, simd_level level) const
+        {
+            return divisions[static_cast<int>(algorithm)][static_cast<int>(level)];
+        }
+
+        uint64_t count(divider_algorithm algorithm) const
+        {
+            uint64_t sum = 0;
+            for (auto n : divisions[static_cast<int>(algorithm)]) {
+                sum += n;
+            }
+            return sum;
+        }
+
+        uint64_t count(simd_level level) const
+        {
+            uint64_t sum = 0;
+            for (auto& by_level : divisions) {
+                sum += by_level[static_cast<int>(level)];
+            }
+            return sum;
+        }
+
+        uint64_t total() const
+        {
+            uint64_t sum = 0;
+            for (auto& by_level : divisions) {
+                for (auto n : by_level) {
+                    sum += n;
+                }
+            }
+            return sum;
+        }
+    };
+
+    namespace detail {
+
+        /// Every thread that divides owns a block of counters, which it alone increments, so
+        /// counting is a plain load and store. Blocks form a list that is only ever prepended
+        /// to. A thread releases its block when it exits and the next new thread takes it over,
+        /// counts included, so there are as many blocks as threads ever ran at once.
+        struct alignas(64) division_counters {
+            std::atomic<uint64_t> divisions[division_statistics::num_algorithms][division_statistics::num_levels];
+            std::atomic<bool> owned;
+            division_counters* next;
+        };
+
+        inline
+        std::atomic<division_counters*>& division_counters_list()
+        {
+            static std::atomic<division_counters*> head(nullptr);
+            return head;
+        }
+
+        struct division_counters_owner {
+            division_counters* counters = nullptr;
+
+            ~division_counters_owner()
+            {
+                if (counters != nullptr) {
+                    counters->owned.store(false, std::memory_order_release);
+                }
+            }
+        };
+
+        inline
+        division_counters* acquire_division_counters()
+        {
+            auto& head = division_counters_list();
+            for (auto* counters = head.load(std::memory_order_acquire); counters != nullptr; counters = counters->next) {
+                bool owned = false;
+                if (counters->owned.compare_exchange_strong(owned, true, std::memory_order_acquire)) {
+                    return counters;
+                }
+            }
+            auto* counters = new division_counters{};
+            counters->owned.store(true, std::memory_order_relaxed);
+            counters->next = head.load(std::memory_order_relaxed);
+            while (!head.compare_exchange_weak(counters->next, counters, std::memory_order_release)) {
+            }
+            return counters;
+        }
+
+        inline
+        void count_divisions(divider_algorithm algorithm, simd_level level, uint64_t count)
+        {
+            // The pointer is constant initialized, so reading it needs no guard. The owner with
+            // its destructor is only touched on the first division of the thread.
+            static thread_local division_counters* counters = nullptr;
+            if (counters == nullptr) {
+                static thread_local division_counters_owner owner;
+                owner.counters = counters = acquire_division_counters();
+            }
+            auto& n = counters->divisions[static_cast<int>(algorithm)][static_cast<int>(level)];
+            n.store(n.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+        }
+
+        /// The level of a division by T, a lane count apart from the scalar one.
+        template <typename T>
+        constexpr simd_level simd_level_of()
+        {
+            return !utility::is_simd<T>::value ? simd_level::scalar :
+                   sizeof(T) == 16 ? simd_level::sse41 :
+                   sizeof(T) == 32 ? simd_level::avx2 : simd_level::avx512;
+        }
+
+        /// Compiled out unless FAST_DIVISION_STATISTICS is defined, and skipped in constant
+        /// expressions, which must not touch the counters.
+        template <typename Integer>
+        constexpr void record_divisions(Integer divisor, simd_level level, uint64_t count)
+        {
+        #if defined(FAST_DIVISION_STATISTICS)
+            if (!__builtin_is_constant_evaluated()) {
+                count_divisions(classify_divisor(divisor), level, count);
+            }
+        #else
+            (void)divisor;
+            (void)level;
+            (void)count;
+        #endif
+        }
+
+        /// One division by T, which counts once per lane.
+        template <typename T, typename Integer>
+        constexpr void record_division(Integer divisor)
+        {
+            record_divisions(divisor, simd_level_of<T>(), utility::is_simd<T>::value ? sizeof(T) / sizeof(Integer) : 1);
+        }
+
+    }
+
+    /// The counts so far. All zero unless statistics_enabled.
+    inline
+    division_statistics statistics_snapshot()
+    {
+        division_statistics sum = {};
+        auto* counters = detail::division_counters_list().load(std::memory_order_acquire);
+        for (; counters != nullptr; counters = counters->next) {
+            for (std::size_t a = 0; a != division_statistics::num_algorithms; ++a) {
+                for (std::size_t l = 0; l != division_statistics::num_levels; ++l) {
+                    sum.divisions[a][l] += counters->divisions[a][l].load(std::memory_order_relaxed);
+                }
+            }
+        }
+        return sum;
+    }
+
+    /// Start counting from zero, e.g. before the job to be profiled. Divisions running in other
+    /// threads meanwhile may be kept or lost.
+    inline
+    void reset_statistics()
+    {
+        auto* counters = detail::division_counters_list().load(std::memory_order_acquire);
+        for (; counters != nullptr; counters = counters->next) {
+            for (auto& by_level : counters->divisions) {
+                for (auto& n : by_level) {
+                    n.store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+}
@@ -0,0 +1,119 @@
+/**
+ *  Fast Division Library
+ *  Created by Stefan Ivanov
+ *
+ *  Using ideas from
+ *  Improved Division by Invariant Integers (2011), algorithms 2 and 4
+ *  by Niels Möller, Torbjörn Granlund
+ */
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include <fast_division/utility/associated_types.hpp>
+#include <fast_division/utility/high_multiplication.hpp>
+#include <fast_division/utility/log2i.hpp>
+#include <fast_division/utility/wide_division.hpp>
+
+namespace fast_division {
+
+    /// Division of a double-word dividend (high, low) by an invariant single-word divisor, as in
+    /// fixed point arithmetic and long division of multi-word integers. The divisor is shifted
+    /// until its top bit is set, and v = floor((2^2N - 1) / d) - 2^N is precomputed for it with
+    /// one slow division. Each division is then the full product v * high, a double-word addition
+    /// and at most two corrections of the estimate, of which the second is rarely taken.
+    /// Requires high < divisor so that the quotient fits in a single word.
+    template <typename UInteger>
+    class double_word_divider {
+    public:
+        static_assert(std::is_unsigned<UInteger>::value, "Double-word division requires an unsigned type");
+
+        constexpr static const unsigned word_size = 8 * sizeof(UInteger);
+        using value_type = UInteger;
+
+        constexpr explicit double_word_divider(UInteger divisor)
+            : divisor_(divisor), normalized_(0), reciprocal_(0), shift_(0)
+        {
+            shift_ = unsigned(word_size - 1 - unsigned(utility::log2i(std::common_type_t<UInteger, unsigned>(divisor))));
+            normalized_ = UInteger(divisor << shift_);
+            // 2^2N - 1 - 2^N * d is (~d, ~0), whose high word is below d, so the quotient is a word.
+            reciprocal_ = utility::divide_double_word(UInteger(~normalized_), UInteger(~UInteger(0)), normalized_);
+        }
+
+        constexpr const UInteger& divisor() const { return divisor_; }
+
+        /// How far the divisor is shifted left to set its top bit.
+        constexpr unsigned shift() const { return shift_; }
+
+        /// The shifted divisor and its reciprocal, for vector kernels of the same division.
+        constexpr const UInteger& normalized() const { return normalized_; }
+        constexpr const UInteger& reciprocal() const { return reciprocal_; }
+
+        /// The quotient of (high, low) by the divisor. The remainder is stored in the last argument.
+        constexpr UInteger divide(UInteger high, UInteger low, UInteger& remainder) const
+        {
+            const UInteger u_1 = shift_ == 0 ? high :
+                UInteger(UInteger(high << shift_) | UInteger(low >> (word_size - shift_)));
+            const UInteger u_0 = UInteger(low << shift_);
+            const UInteger quotient = divide_normalized(u_1, u_0, remainder);
+            remainder = UInteger(remainder >> shift_);
+            return quotient;
+        }
+
+        /// The same division of a dividend already shifted left by shift(), whose remainder is
+        /// left shifted as well. Long division keeps its running remainder in this form, so the
+        /// shifts are not part of the chain of dependent divisions.
+        constexpr UInteger divide_normalized(UInteger u_1, UInteger u_0, UInteger& remainder) const
+        {
+            // (q_1, q_0) = v * u_1 + (u_1 + 1, u_0)
+            UInteger q_0 = utility::low_mult(reciprocal_, u_1);
+            UInteger q_1 = utility::high_mult(reciprocal_, u_1);
+            q_0 = UInteger(q_0 + u_0);
+            q_1 = UInteger(q_1 + u_1 + UInteger(1) + UInteger(q_0 < u_0));
+
+            UInteger r = UInteger(u_0 - utility::low_mult(q_1, normalized_));
+            if (r > q_0) {
+                q_1 = UInteger(q_1 - UInteger(1));
+                r = UInteger(r + normalized_);
+            }
+            if (r >= normalized_) {
+                q_1 = UInteger(q_1 + UInteger(1));
+                r = UInteger(r - normalized_);
+            }
+            remainder = r;
+            return q_1;
+        }
+
+        constexpr UInteger operator()(UInteger high, UInteger low) const
+        {
+            UInteger remainder = 0;
+            return divide(high, low, remainder);
+        }
+
+        constexpr UInteger remainder(UInteger high, UInteger low) const
+        {
+            UInteger remainder = 0;
+            divide(high, low, remainder);
+            return remainder;
+        }
+
+        friend constexpr
+        bool operator== (const double_word_divider& x, const double_word_divider& y)
+        {
+            return x.divisor_ == y.divisor_;
+        }
+        friend constexpr
+        bool operator!= (const double_word_divider& x, const double_word_divider& y)
+        {
+            return !(x == y);
+        }
+
+    private:
+        UInteger divisor_;
+        UInteger normalized_;
+        UInteger reciprocal_;
+        unsigned shift_;
+    };
+
+}
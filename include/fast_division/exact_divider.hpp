@@ -0,0 +1,165 @@
+/**
+ *  Fast Division Library
+ *  Created by Stefan Ivanov
+ *
+ *  Using ideas from
+ *  Division by Invariant Integers Using Multiplication (1994), section 9
+ *  by Torbjörn Granlund, Peter L. Montgomery
+ */
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include <fast_division/fast_division_simd.hpp>
+#include <fast_division/utility/associated_types.hpp>
+#include <fast_division/utility/log2i.hpp>
+#include <fast_division/utility/modular_inverse.hpp>
+
+namespace fast_division {
+
+    /// Division by an invariant integer when the dividend is known to be a multiple of it, and
+    /// divisibility testing. Write d = 2^k * d' with d' odd. A multiple n of d divided by d is
+    /// (n >> k) times the inverse of d' modulo 2^N, i.e. one low multiplication. For any n,
+    /// rotating n * inverse(d') right by k gives at most (2^N - 1) / d exactly when d divides n.
+    /// Signed divisors use the inverse of their magnitude and negate the quotient.
+    template <typename Integer>
+    class exact_divider {
+    public:
+        constexpr static const auto word_size = sizeof(Integer) * 8;
+        using value_type = Integer;
+        using u_type = std::make_unsigned_t<Integer>;
+
+        constexpr explicit exact_divider(Integer divisor)
+            : divisor_(divisor), inverse_(0), limit_(0), shift_(0), sign_(0)
+        {
+            u_type abs_divisor = u_type(divisor);
+            if (divisor < 0) {
+                sign_ = Integer(-1);
+                abs_divisor = u_type(u_type(0) - abs_divisor);
+            }
+            shift_ = u_type(utility::log2i(u_type(abs_divisor & u_type(u_type(0) - abs_divisor))));
+            inverse_ = utility::modular_inverse(u_type(abs_divisor >> shift_));
+            limit_ = u_type(std::numeric_limits<u_type>::max() / abs_divisor);
+        }
+
+        constexpr const Integer& divisor() const { return divisor_; }
+
+        /// The quotient of a multiple of the divisor. Other dividends give meaningless results.
+        constexpr Integer operator()(Integer input) const
+        {
+            Integer q = Integer(utility::low_mult(u_type(Integer(input >> shift_)), inverse_));
+            return Integer((q ^ sign_) - sign_);
+        }
+
+        template <typename Simd, typename = std::enable_if_t<utility::is_simd<Simd>::value>>
+        Simd operator()(Simd input) const
+        {
+            static_assert(sizeof(Simd) == 0, "Division by a simd vector must use a specialization");
+            return input;
+        }
+
+        /// Whether the divisor divides input, without computing a remainder.
+        constexpr bool divides(Integer input) const
+        {
+            u_type abs_input = input < 0 ? u_type(u_type(0) - u_type(input)) : u_type(input);
+            u_type x = utility::low_mult(abs_input, inverse_);
+            // Rotate right by shift_. The left shift is reduced modulo N so that 0 is not UB.
+            u_type rotated = u_type(u_type(x >> shift_) | u_type(x << ((word_size - shift_) % word_size)));
+            return rotated <= limit_;
+        }
+
+        /// Lanes of all ones where the divisor divides the input and zero elsewhere.
+        template <typename Simd, typename = std::enable_if_t<utility::is_simd<Simd>::value>>
+        Simd divides(Simd input) const
+        {
+            static_assert(sizeof(Simd) == 0, "Divisibility of a simd vector must use a specialization");
+            return input;
+        }
+
+        friend constexpr
+        bool operator== (const exact_divider& x, const exact_divider& y)
+        {
+            return x.divisor_ == y.divisor_;
+        }
+        friend constexpr
+        bool operator!= (const exact_divider& x, const exact_divider& y)
+        {
+            return x.divisor_ != y.divisor_;
+        }
+
+    private:
+        Integer divisor_;
+        u_type inverse_;
+        u_type limit_;
+        u_type shift_;
+        Integer sign_;
+    };
+
+    template <typename Integer>
+    inline constexpr
+    bool divisible_by(Integer divident, const exact_divider<Integer>& divisor)
+    {
+        return divisor.divides(divident);
+    }
+
+    /// Specializations for various simd types.
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_SSE41
+    __m128i exact_divider<uint32_t>::operator()<> (__m128i input) const
+    {
+        return detail::exact_divide_epu32(input, inverse_, shift_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX2
+    __m256i exact_divider<uint32_t>::operator()<> (__m256i input) const
+    {
+        return detail::exact_divide_epu32(input, inverse_, shift_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_SSE41
+    __m128i exact_divider<int32_t>::operator()<> (__m128i input) const
+    {
+        return detail::exact_divide_epi32(input, inverse_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX2
+    __m256i exact_divider<int32_t>::operator()<> (__m256i input) const
+    {
+        return detail::exact_divide_epi32(input, inverse_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_SSE41
+    __m128i exact_divider<uint32_t>::divides<> (__m128i input) const
+    {
+        return detail::divisible_epu32(input, inverse_, shift_, limit_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX2
+    __m256i exact_divider<uint32_t>::divides<> (__m256i input) const
+    {
+        return detail::divisible_epu32(input, inverse_, shift_, limit_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_SSE41
+    __m128i exact_divider<int32_t>::divides<> (__m128i input) const
+    {
+        return detail::divisible_epu32(_mm_abs_epi32(input), inverse_, shift_, limit_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX2
+    __m256i exact_divider<int32_t>::divides<> (__m256i input) const
+    {
+        return detail::divisible_epu32(_mm256_abs_epi32(input), inverse_, shift_, limit_);
+    }
+
+}
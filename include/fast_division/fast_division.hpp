@@ -8,16 +8,27 @@
  */
 #pragma once
 
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <type_traits>
 #include <utility>
 
 #include <fast_division/fast_division_base.hpp>
 #include <fast_division/division_policy.hpp>
+#include <fast_division/fast_division_dispatch.hpp>
+#include <fast_division/division_statistics.hpp>
 
 
 namespace fast_division {
 
+    /// Quotient and remainder of a truncating division, in the spirit of std::div_t.
+    template <typename T>
+    struct divmod_result {
+        T quotient;
+        T remainder;
+    };
+
     template <typename Integer, template <typename I, bool S> class DivisionPolicy = promotion_policy>
     class constant_divider : constant_divider_base<Integer, std::is_signed<Integer>::value,
                                                    DivisionPolicy> {
@@ -26,52 +37,187 @@ namespace fast_division {
         using base::word_size;
         using value_type = Integer;
         
-        explicit constant_divider(Integer divisor)
-            : divisor_(divisor), constant_divider_base(divisor)
+        constexpr explicit constant_divider(Integer divisor)
+            : base(divisor), divisor_(divisor)
+        {}
+
+        /// From the three constants of the base computed elsewhere, see precomputed_t.
+        constexpr constant_divider(precomputed_t, Integer divisor, Integer c_1, Integer c_2, Integer c_3)
+            : base(precomputed, c_1, c_2, c_3), divisor_(divisor)
         {}
 
-        const Integer& divisor() const { return divisor_; }
+        constexpr const Integer& divisor() const { return divisor_; }
 
-        template <typename T>
-        auto operator()(T&& input) const
+        /// The class of the divisor and the constants of the base, e.g. constants().multiplier(),
+        /// to see which path the divisions take.
+        constexpr divider_algorithm algorithm() const { return classify_divisor(divisor_); }
+        constexpr const base& constants() const { return *this; }
+
+        template <typename T, typename = std::enable_if_t<!utility::is_simd<std::decay_t<T>>::value>>
+        constexpr auto operator()(T&& input) const
         {
+            detail::record_division<std::decay_t<T>>(divisor_);
             return base::operator()(std::forward<T>(input));
         }
 
+        /// Vectors are divided by overloads with the target of their width, which pass them in
+        /// registers of that width to and from the kernels. Types without vector kernels fail
+        /// to compile when these are called. The vector divmod overloads are templates only so
+        /// that divmod_result is not named with a vector type, whose attributes it would drop.
+
+        FAST_DIVISION_TARGET_SSE41
+        __m128i operator()(__m128i input) const
+        {
+            detail::record_division<__m128i>(divisor_);
+            return base::operator()(input);
+        }
+
+        FAST_DIVISION_TARGET_AVX2
+        __m256i operator()(__m256i input) const
+        {
+            detail::record_division<__m256i>(divisor_);
+            return base::operator()(input);
+        }
+
+        FAST_DIVISION_TARGET_AVX512
+        __m512i operator()(__m512i input) const
+        {
+            detail::record_division<__m512i>(divisor_);
+            return base::operator()(input);
+        }
+
+        /// Quotient and remainder from a single reciprocal multiplication. The remainder
+        /// has the sign of the dividend, like the built-in %.
+        constexpr divmod_result<Integer> divmod(Integer input) const
+        {
+            detail::record_division<Integer>(divisor_);
+            Integer q = base::operator()(input);
+            return { q, Integer(input - Integer(q * divisor_)) };
+        }
+
+        template <typename Simd, std::enable_if_t<utility::is_simd<Simd>::value && sizeof(Simd) == 16, int> = 0>
+        FAST_DIVISION_TARGET_SSE41
+        divmod_result<Simd> divmod(Simd input) const
+        {
+            detail::record_division<Simd>(divisor_);
+            Simd q = base::operator()(input);
+            return { q, detail::subtract_product(input, q, divisor_) };
+        }
+
+        template <typename Simd, std::enable_if_t<utility::is_simd<Simd>::value && sizeof(Simd) == 32, int> = 0>
+        FAST_DIVISION_TARGET_AVX2
+        divmod_result<Simd> divmod(Simd input) const
+        {
+            detail::record_division<Simd>(divisor_);
+            Simd q = base::operator()(input);
+            return { q, detail::subtract_product(input, q, divisor_) };
+        }
+
+        template <typename Simd, std::enable_if_t<utility::is_simd<Simd>::value && sizeof(Simd) == 64, int> = 0>
+        FAST_DIVISION_TARGET_AVX512
+        divmod_result<Simd> divmod(Simd input) const
+        {
+            detail::record_division<Simd>(divisor_);
+            Simd q = base::operator()(input);
+            return { q, detail::subtract_product(input, q, divisor_) };
+        }
+
+        constexpr Integer remainder(Integer input) const
+        {
+            detail::record_division<Integer>(divisor_);
+            return base::remainder(input, divisor_);
+        }
+
+        FAST_DIVISION_TARGET_SSE41
+        __m128i remainder(__m128i input) const
+        {
+            detail::record_division<__m128i>(divisor_);
+            return detail::subtract_product(input, base::operator()(input), divisor_);
+        }
+
+        FAST_DIVISION_TARGET_AVX2
+        __m256i remainder(__m256i input) const
+        {
+            detail::record_division<__m256i>(divisor_);
+            return detail::subtract_product(input, base::operator()(input), divisor_);
+        }
+
+        FAST_DIVISION_TARGET_AVX512
+        __m512i remainder(__m512i input) const
+        {
+            detail::record_division<__m512i>(divisor_);
+            return detail::subtract_product(input, base::operator()(input), divisor_);
+        }
+
+        /// Divide size integers from input into output with the widest SIMD kernel
+        /// available at runtime, see fast_division_dispatch.hpp. The arrays may be
+        /// the same but must not otherwise overlap.
+        void divide(const Integer* input, Integer* output, std::size_t size) const
+        {
+            if (statistics_enabled) {
+                const bool simd = has_simd_kernels<Integer, DivisionPolicy>::value;
+                detail::record_divisions(divisor_, simd ? active_simd_level() : simd_level::scalar, size);
+            }
+            detail::divide_array(static_cast<const base&>(*this), input, output, size);
+        }
+
+        /// Divide a contiguous range (anything with data() and size(), e.g. std::vector,
+        /// std::array or std::span) into another one of at least the same size.
+        template <typename InputRange, typename OutputRange>
+        void divide(const InputRange& input, OutputRange&& output) const
+        {
+            assert(output.size() >= input.size());
+            divide(input.data(), output.data(), input.size());
+        }
+
+        void divide_in_place(Integer* data, std::size_t size) const
+        {
+            divide(data, data, size);
+        }
+
+        template <typename Range>
+        void divide_in_place(Range&& data) const
+        {
+            divide(data.data(), data.data(), data.size());
+        }
+
         /// Equality and comparison operators delegating to the underlying divisor.
 
-        friend
+        friend constexpr
         bool operator== (const constant_divider& x, const constant_divider& y)
         {
             return x.divisor_ == y.divisor_;
         }
-        friend
+        friend constexpr
         bool operator!= (const constant_divider& x, const constant_divider& y)
         {
             return x.divisor_ != y.divisor_;
         }
-        friend
+        friend constexpr
         bool operator<  (const constant_divider& x, const constant_divider& y)
         {
             return x.divisor_ < y.divisor_;
         }
-        friend
+        friend constexpr
         bool operator>  (const constant_divider& x, const constant_divider& y)
         {
             return x.divisor_ > y.divisor_;
         }
-        friend
+        friend constexpr
         bool operator<= (const constant_divider& x, const constant_divider& y)
         {
             return x.divisor_ <= y.divisor_;
         }
-        friend
+        friend constexpr
         bool operator>= (const constant_divider& x, const constant_divider& y)
         {
             return x.divisor_ >= y.divisor_;
         }
 
     private:
+        template <typename I, template <typename, bool> class P, bool S>
+        friend class packed_divider;
+
         Integer divisor_;
     };
 
@@ -79,10 +225,17 @@ namespace fast_division {
     /// Furthermore, this provides a more natural syntax for use.
 
     template <typename Integer, template <typename, bool> class DivisionPolicy, typename T>
-    inline
+    inline constexpr
     Integer operator/ (T&& divident, const constant_divider<Integer, DivisionPolicy>& divisor)
     {
         return divisor(std::forward<T>(divident));
     }
 
+    template <typename Integer, template <typename, bool> class DivisionPolicy, typename T>
+    inline constexpr
+    Integer operator% (T&& divident, const constant_divider<Integer, DivisionPolicy>& divisor)
+    {
+        return divisor.remainder(std::forward<T>(divident));
+    }
+
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <algorithm>
+#include <type_traits>
 
 #include <fast_division/division_policy.hpp>
 #include <fast_division/utility/log2i.hpp>
@@ -16,13 +17,25 @@
 
 namespace fast_division {
 
+    /// Tag for building a divider from constants computed elsewhere, e.g. many at once by
+    /// make_dividers in divider_batch.hpp. The constants must be those the divisor would give.
+    struct precomputed_t {
+        explicit precomputed_t() = default;
+    };
+
+    constexpr precomputed_t precomputed{};
+
+    template <typename Integer, template <typename I, bool S> class DivisionPolicy, bool Signed>
+    class packed_divider;
+
     template<typename Integer, bool Signed, template <typename I, bool S> class DivisionPolicy>
     class constant_divider_base {
     public:
         constexpr static const auto word_size = sizeof(Integer) * 8;
         using division_policy = DivisionPolicy<Integer, Signed>;
 
-        explicit constant_divider_base(Integer divisor)
+        constexpr explicit constant_divider_base(Integer divisor)
+            : multiplier_(0), shift_1_(0), shift_2_(0)
         {
             if (divisor == 1) { // A no-op.
                 multiplier_ = shift_1_ = shift_2_ = 0;
@@ -46,22 +59,44 @@ namespace fast_division {
             }
         }
 
-        Integer operator()(Integer input)  const
+        constexpr constant_divider_base(precomputed_t, Integer multiplier, Integer shift_1, Integer shift_2)
+            : multiplier_(multiplier), shift_1_(shift_1), shift_2_(shift_2)
+        {}
+
+        /// The constants, to see which path a divisor takes. The multiplier and both shifts are 0
+        /// for 1, and the multiplier is 0 for powers of two, which only shift by post_shift().
+        constexpr const Integer& multiplier() const { return multiplier_; }
+        constexpr const Integer& add_shift() const { return shift_1_; }
+        constexpr const Integer& post_shift() const { return shift_2_; }
+
+        /// Whether the multiplier is N + 1 bits wide, so that the quotient needs the add step.
+        constexpr bool add_step() const { return shift_1_ != 0; }
+
+        constexpr Integer operator()(Integer input)  const
         {
             Integer q = utility::high_mult(multiplier_, input);
             q = (q + ((input - q) >> shift_1_)) >> shift_2_;
             return q;
         }
 
+        /// The remainder given the divisor, which the base does not store.
+        constexpr Integer remainder(Integer input, Integer divisor) const
+        {
+            return Integer(input - Integer(operator()(input) * divisor));
+        }
+
 
         template <typename Simd, typename = std::enable_if_t<utility::is_simd<Simd>::value>>
         Simd operator()(Simd input) const
         {
-            static_assert(false, "Division by a simd vector must use a specialization");
+            static_assert(sizeof(Simd) == 0, "Division by a simd vector must use a specialization");
             return input;
         }
 
     private:
+        template <typename I, template <typename, bool> class P, bool S>
+        friend class packed_divider;
+
         Integer multiplier_;
         Integer shift_1_;
         Integer shift_2_;
@@ -73,44 +108,167 @@ namespace fast_division {
         constexpr static const auto word_size = sizeof(Integer) * 8;
         using division_policy = DivisionPolicy<Integer, true>;
 
-        explicit constant_divider_base(Integer divisor)
+        constexpr explicit constant_divider_base(Integer divisor)
+            : multiplier_(0), shift_(0), sign_(0)
         {
-            std::make_unsigned_t<Integer> abs_divisor;
+            using u_type = std::make_unsigned_t<Integer>;
+            u_type abs_divisor = 0;
             if (divisor < 0) {
                 sign_ = Integer(-1);
-                abs_divisor = -divisor;
+                abs_divisor = u_type(u_type(0) - u_type(divisor));
             }
             else {
                 sign_ = Integer(0);
-                abs_divisor = divisor;
+                abs_divisor = u_type(divisor);
             }
 
-            Integer l = utility::log2i(abs_divisor - 1) + 1;
-            l = std::max(l, Integer(1));
+            // The bit scan is undefined for zero, so a divisor of magnitude 1 is handled separately.
+            Integer l = abs_divisor == u_type(1) ? Integer(1) : Integer(utility::log2i(abs_divisor - 1) + 1);
             //multiplier_ = 1 + Integer((p_type(1) << (word_size + shift_)) / abs_divisor - (p_type(1) << word_size));
             multiplier_ = division_policy::calculate_multiplier(abs_divisor, l);
             shift_ = l - 1;
         }
 
-        Integer operator()(Integer input) const
+        constexpr constant_divider_base(precomputed_t, Integer multiplier, Integer shift, Integer sign)
+            : multiplier_(multiplier), shift_(shift), sign_(sign)
+        {}
+
+        constexpr const Integer& multiplier() const { return multiplier_; }
+        constexpr const Integer& post_shift() const { return shift_; }
+        constexpr bool negative() const { return sign_ != 0; }
+
+        /// The product is always added to the input, as the multiplier is N + 1 bits wide.
+        constexpr bool add_step() const { return true; }
+
+        constexpr Integer operator()(Integer input) const
         {
             Integer q = input + utility::high_mult(multiplier_, input);
             q = (q >> shift_) - (input >= 0 ? 0 : -1);
             return (q ^ sign_) - sign_;
         }
 
+        /// The remainder given the divisor, which the base does not store.
+        constexpr Integer remainder(Integer input, Integer divisor) const
+        {
+            return Integer(input - Integer(operator()(input) * divisor));
+        }
+
         template <typename Simd, typename = std::enable_if_t<utility::is_simd<Simd>::value>>
         Simd operator()(Simd input) const
         {
-            static_assert(false, "Division by a simd vector must use a specialization");
+            static_assert(sizeof(Simd) == 0, "Division by a simd vector must use a specialization");
             return input;
         }
 
     private:
+        template <typename I, template <typename, bool> class P, bool S>
+        friend class packed_divider;
+
         Integer multiplier_;
         Integer shift_;
         Integer sign_;
 
     };
 
+    /// Specializations for fastmod_policy, which evaluates the quotient and the remainder
+    /// directly from the 2N-bit reciprocal.
+
+    template <typename Integer>
+    class constant_divider_base<Integer, false, fastmod_policy> {
+    public:
+        constexpr static const auto word_size = sizeof(Integer) * 8;
+        using division_policy = fastmod_policy<Integer, false>;
+        using reciprocal_type = typename division_policy::reciprocal_type;
+
+        constexpr explicit constant_divider_base(Integer divisor)
+            : reciprocal_(division_policy::calculate_reciprocal(divisor)),
+              one_mask_(divisor == Integer(1) ? Integer(-1) : Integer(0))
+        {}
+
+        constexpr const reciprocal_type& reciprocal() const { return reciprocal_; }
+
+        constexpr bool add_step() const { return false; }
+
+        constexpr Integer operator()(Integer input) const
+        {
+            // The reciprocal of 1 wraps around to 0, in which case the quotient is the input.
+            return Integer(utility::high_mult(reciprocal_, reciprocal_type(input)) | (input & one_mask_));
+        }
+
+        constexpr Integer remainder(Integer input, Integer divisor) const
+        {
+            reciprocal_type fraction = utility::low_mult(reciprocal_, reciprocal_type(input));
+            return Integer(utility::high_mult(fraction, reciprocal_type(divisor)));
+        }
+
+        template <typename Simd, typename = std::enable_if_t<utility::is_simd<Simd>::value>>
+        Simd operator()(Simd input) const
+        {
+            static_assert(sizeof(Simd) == 0, "Division by a simd vector must use a specialization");
+            return input;
+        }
+
+    private:
+        reciprocal_type reciprocal_;
+        Integer one_mask_;
+    };
+
+    /// Signed division goes through the magnitudes and applies the signs like the
+    /// signed base above, so that every divisor including -1 and the minimum is supported.
+    template <typename Integer>
+    class constant_divider_base<Integer, true, fastmod_policy> {
+    public:
+        constexpr static const auto word_size = sizeof(Integer) * 8;
+        using division_policy = fastmod_policy<Integer, true>;
+        using u_type = std::make_unsigned_t<Integer>;
+        using reciprocal_type = typename division_policy::reciprocal_type;
+
+        constexpr explicit constant_divider_base(Integer divisor)
+            : reciprocal_(division_policy::calculate_reciprocal(abs(divisor))),
+              one_mask_(abs(divisor) == u_type(1) ? u_type(-1) : u_type(0)),
+              sign_(divisor < 0 ? Integer(-1) : Integer(0))
+        {}
+
+        constexpr const reciprocal_type& reciprocal() const { return reciprocal_; }
+        constexpr bool negative() const { return sign_ != 0; }
+
+        constexpr bool add_step() const { return false; }
+
+        constexpr Integer operator()(Integer input) const
+        {
+            Integer input_sign = Integer(input >> (word_size - 1));
+            u_type abs_input = abs(input);
+            u_type q = u_type(utility::high_mult(reciprocal_, reciprocal_type(abs_input)) | (abs_input & one_mask_));
+            // Negate in unsigned arithmetic, since the magnitude of min / 1 does not fit in Integer.
+            u_type sign = u_type(input_sign ^ sign_);
+            return Integer(u_type(u_type(q ^ sign) - sign));
+        }
+
+        constexpr Integer remainder(Integer input, Integer divisor) const
+        {
+            // The remainder takes the sign of the dividend only.
+            Integer input_sign = Integer(input >> (word_size - 1));
+            reciprocal_type fraction = utility::low_mult(reciprocal_, reciprocal_type(abs(input)));
+            Integer r = Integer(utility::high_mult(fraction, reciprocal_type(abs(divisor))));
+            return Integer((r ^ input_sign) - input_sign);
+        }
+
+        template <typename Simd, typename = std::enable_if_t<utility::is_simd<Simd>::value>>
+        Simd operator()(Simd input) const
+        {
+            static_assert(sizeof(Simd) == 0, "Division by a simd vector must use a specialization");
+            return input;
+        }
+
+    private:
+        constexpr static u_type abs(Integer x)
+        {
+            return x < 0 ? u_type(u_type(0) - u_type(x)) : u_type(x);
+        }
+
+        reciprocal_type reciprocal_;
+        u_type one_mask_;
+        Integer sign_;
+    };
+
 }
@@ -0,0 +1,257 @@
+/**
+ *  Fast Division Library
+ *  Created by Stefan Ivanov
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <fast_division/fast_division_base.hpp>
+#include <fast_division/fast_division_simd.hpp>
+#include <fast_division/utility/cpu_features.hpp>
+
+namespace fast_division {
+
+    /// The widest SIMD level supported by the processor and the operating system.
+    /// Detected once on first use.
+    inline
+    simd_level detected_simd_level()
+    {
+        static const simd_level level = utility::detect_simd_level();
+        return level;
+    }
+
+    namespace detail {
+
+        inline
+        std::atomic<int>& active_simd_level_state()
+        {
+            static std::atomic<int> level(static_cast<int>(detected_simd_level()));
+            return level;
+        }
+
+    }
+
+    /// The SIMD level bulk division currently dispatches to.
+    inline
+    simd_level active_simd_level()
+    {
+        return static_cast<simd_level>(detail::active_simd_level_state().load(std::memory_order_relaxed));
+    }
+
+    /// Restrict bulk division to the given SIMD level, e.g. to test every kernel on one machine.
+    /// Levels above the detected one are clamped to it. Returns the level actually in effect.
+    inline
+    simd_level force_simd_level(simd_level level)
+    {
+        auto clamped = std::min(static_cast<int>(level), static_cast<int>(detected_simd_level()));
+        detail::active_simd_level_state().store(clamped, std::memory_order_relaxed);
+        return static_cast<simd_level>(clamped);
+    }
+
+    /// Go back to dispatching to the detected SIMD level.
+    inline
+    void reset_simd_level()
+    {
+        force_simd_level(detected_simd_level());
+    }
+
+    namespace detail {
+
+        template <typename Integer, bool Signed, template <typename, bool> class DivisionPolicy>
+        inline
+        void divide_array_scalar(const constant_divider_base<Integer, Signed, DivisionPolicy>& divider,
+                                 const Integer* input, Integer* output, std::size_t size)
+        {
+            for (std::size_t i = 0; i != size; ++i) {
+                output[i] = divider(input[i]);
+            }
+        }
+
+        /// Number of leading elements to process before output reaches an Alignment boundary.
+        template <std::size_t Alignment, typename Integer>
+        inline
+        std::size_t unaligned_head(const Integer* output, std::size_t size)
+        {
+            auto misalignment = reinterpret_cast<std::uintptr_t>(output) % Alignment;
+            auto head = misalignment == 0 ? std::size_t(0) : (Alignment - misalignment) / sizeof(Integer);
+            return std::min(head, size);
+        }
+
+        /// Divide fewer than a vector's worth of elements. Masked loads and stores are used
+        /// where the instruction set has them for the element size, otherwise a scalar loop.
+
+        template <typename Integer, bool Signed, template <typename, bool> class DivisionPolicy, std::size_t Size>
+        inline
+        void divide_partial_avx2(const constant_divider_base<Integer, Signed, DivisionPolicy>& divider,
+                                 const Integer* input, Integer* output, std::size_t size,
+                                 std::integral_constant<std::size_t, Size>)
+        {
+            divide_array_scalar(divider, input, output, size);
+        }
+
+        template <typename Integer, bool Signed, template <typename, bool> class DivisionPolicy>
+        inline FAST_DIVISION_TARGET_AVX2
+        void divide_partial_avx2(const constant_divider_base<Integer, Signed, DivisionPolicy>& divider,
+                                 const Integer* input, Integer* output, std::size_t size,
+                                 std::integral_constant<std::size_t, 4>)
+        {
+            __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(int(size)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+            __m256i n = _mm256_maskload_epi32(reinterpret_cast<const int*>(input), mask);
+            _mm256_maskstore_epi32(reinterpret_cast<int*>(output), mask, divider(n));
+        }
+
+        template <typename Integer, bool Signed, template <typename, bool> class DivisionPolicy, std::size_t Size>
+        inline
+        void divide_partial_avx512(const constant_divider_base<Integer, Signed, DivisionPolicy>& divider,
+                                   const Integer* input, Integer* output, std::size_t size,
+                                   std::integral_constant<std::size_t, Size>)
+        {
+            divide_array_scalar(divider, input, output, size);
+        }
+
+        template <typename Integer, bool Signed, template <typename, bool> class DivisionPolicy>
+        inline FAST_DIVISION_TARGET_AVX512
+        void divide_partial_avx512(const constant_divider_base<Integer, Signed, DivisionPolicy>& divider,
+                                   const Integer* input, Integer* output, std::size_t size,
+                                   std::integral_constant<std::size_t, 4>)
+        {
+            __mmask16 mask = __mmask16((1u << size) - 1u);
+            __m512i n = _mm512_maskz_loadu_epi32(mask, input);
+            _mm512_mask_storeu_epi32(output, mask, divider(n));
+        }
+
+        /// The bulk kernels align the output for the main loop, run four independent vectors per
+        /// iteration so that the latency of the multiplications overlaps, and finish with a partial
+        /// vector. Input and output may be the same array but must not otherwise overlap.
+
+        template <typename Integer, bool Signed, template <typename, bool> class DivisionPolicy>
+        inline FAST_DIVISION_TARGET_SSE41
+        void divide_array_sse41(const constant_divider_base<Integer, Signed, DivisionPolicy>& divider,
+                                const Integer* input, Integer* output, std::size_t size)
+        {
+            constexpr std::size_t lanes = sizeof(__m128i) / sizeof(Integer);
+            std::size_t i = unaligned_head<sizeof(__m128i)>(output, size);
+            divide_array_scalar(divider, input, output, i);
+            for (; i + 4 * lanes <= size; i += 4 * lanes) {
+                __m128i n_0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+                __m128i n_1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i + lanes));
+                __m128i n_2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i + 2 * lanes));
+                __m128i n_3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i + 3 * lanes));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), divider(n_0));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i + lanes), divider(n_1));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i + 2 * lanes), divider(n_2));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i + 3 * lanes), divider(n_3));
+            }
+            for (; i + lanes <= size; i += lanes) {
+                __m128i n = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), divider(n));
+            }
+            // SSE has no efficient masked store, so the tail stays scalar.
+            divide_array_scalar(divider, input + i, output + i, size - i);
+        }
+
+        template <typename Integer, bool Signed, template <typename, bool> class DivisionPolicy>
+        inline FAST_DIVISION_TARGET_AVX2
+        void divide_array_avx2(const constant_divider_base<Integer, Signed, DivisionPolicy>& divider,
+                               const Integer* input, Integer* output, std::size_t size)
+        {
+            constexpr std::size_t lanes = sizeof(__m256i) / sizeof(Integer);
+            using element_size = std::integral_constant<std::size_t, sizeof(Integer)>;
+            std::size_t i = unaligned_head<sizeof(__m256i)>(output, size);
+            if (i != 0) {
+                divide_partial_avx2(divider, input, output, i, element_size{});
+            }
+            for (; i + 4 * lanes <= size; i += 4 * lanes) {
+                __m256i n_0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+                __m256i n_1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i + lanes));
+                __m256i n_2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i + 2 * lanes));
+                __m256i n_3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i + 3 * lanes));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), divider(n_0));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i + lanes), divider(n_1));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i + 2 * lanes), divider(n_2));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i + 3 * lanes), divider(n_3));
+            }
+            for (; i + lanes <= size; i += lanes) {
+                __m256i n = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), divider(n));
+            }
+            if (i != size) {
+                divide_partial_avx2(divider, input + i, output + i, size - i, element_size{});
+            }
+        }
+
+        template <typename Integer, bool Signed, template <typename, bool> class DivisionPolicy>
+        inline FAST_DIVISION_TARGET_AVX512
+        void divide_array_avx512(const constant_divider_base<Integer, Signed, DivisionPolicy>& divider,
+                                 const Integer* input, Integer* output, std::size_t size)
+        {
+            constexpr std::size_t lanes = sizeof(__m512i) / sizeof(Integer);
+            using element_size = std::integral_constant<std::size_t, sizeof(Integer)>;
+            std::size_t i = unaligned_head<sizeof(__m512i)>(output, size);
+            if (i != 0) {
+                divide_partial_avx512(divider, input, output, i, element_size{});
+            }
+            for (; i + 4 * lanes <= size; i += 4 * lanes) {
+                __m512i n_0 = _mm512_loadu_si512(input + i);
+                __m512i n_1 = _mm512_loadu_si512(input + i + lanes);
+                __m512i n_2 = _mm512_loadu_si512(input + i + 2 * lanes);
+                __m512i n_3 = _mm512_loadu_si512(input + i + 3 * lanes);
+                _mm512_storeu_si512(output + i, divider(n_0));
+                _mm512_storeu_si512(output + i + lanes, divider(n_1));
+                _mm512_storeu_si512(output + i + 2 * lanes, divider(n_2));
+                _mm512_storeu_si512(output + i + 3 * lanes, divider(n_3));
+            }
+            for (; i + lanes <= size; i += lanes) {
+                _mm512_storeu_si512(output + i, divider(_mm512_loadu_si512(input + i)));
+            }
+            if (i != size) {
+                divide_partial_avx512(divider, input + i, output + i, size - i, element_size{});
+            }
+        }
+
+        template <typename Integer, bool Signed, template <typename, bool> class DivisionPolicy>
+        inline
+        void divide_array(const constant_divider_base<Integer, Signed, DivisionPolicy>& divider,
+                          const Integer* input, Integer* output, std::size_t size, std::false_type)
+        {
+            divide_array_scalar(divider, input, output, size);
+        }
+
+        template <typename Integer, bool Signed, template <typename, bool> class DivisionPolicy>
+        inline
+        void divide_array(const constant_divider_base<Integer, Signed, DivisionPolicy>& divider,
+                          const Integer* input, Integer* output, std::size_t size, std::true_type)
+        {
+            switch (active_simd_level()) {
+            case simd_level::avx512:
+                divide_array_avx512(divider, input, output, size);
+                break;
+            case simd_level::avx2:
+                divide_array_avx2(divider, input, output, size);
+                break;
+            case simd_level::sse41:
+                divide_array_sse41(divider, input, output, size);
+                break;
+            default:
+                divide_array_scalar(divider, input, output, size);
+            }
+        }
+
+        /// Route bulk division to the widest kernel available at runtime. Divider types without
+        /// SIMD specializations always use the scalar loop.
+        template <typename Integer, bool Signed, template <typename, bool> class DivisionPolicy>
+        inline
+        void divide_array(const constant_divider_base<Integer, Signed, DivisionPolicy>& divider,
+                          const Integer* input, Integer* output, std::size_t size)
+        {
+            divide_array(divider, input, output, size, has_simd_kernels<Integer, DivisionPolicy>{});
+        }
+
+    }
+
+}
@@ -10,71 +10,857 @@
 
 #include <immintrin.h>
 #include <cstdint>
+#include <type_traits>
 
 #include <fast_division/fast_division_base.hpp>
 #include <fast_division/division_policy.hpp>
 #include <fast_division/utility/associated_types.hpp>
+#include <fast_division/utility/cpu_features.hpp>
+
+FAST_DIVISION_AVX512_WARNINGS_PUSH
 
 namespace fast_division {
 
+    namespace detail {
+
+        /// Kernels shared by all division policies, since the policy only affects how the
+        /// multiplier is computed and not how it is applied.
+
+        inline FAST_DIVISION_TARGET_SSE41
+        __m128i divide_epu32(__m128i input, uint32_t multiplier, uint32_t shift_1, uint32_t shift_2)
+        {
+            __m128i m = _mm_set1_epi32(multiplier);
+            __m128i s1 = _mm_setr_epi32(shift_1, 0, 0, 0);
+            __m128i s2 = _mm_setr_epi32(shift_2, 0, 0, 0);
+            // Multiply unsigned integers at positions 0 and 2 in n with the multiplier.
+            __m128i batch_1_unshifted = _mm_mul_epu32(input, m);
+            // Store the high bits of the results.
+            __m128i batch_1 = _mm_srli_epi64(batch_1_unshifted, 32);
+            // Shift the input in order to compute the product of the integers at positions 1 and 3.
+            __m128i n_shift = _mm_srli_epi64(input, 32);
+            __m128i batch_2 = _mm_mul_epu32(n_shift, m);
+            // Create a mask to extract the correct bits in the two batches.
+            __m128i mask = _mm_set_epi32(-1, 0, -1, 0);
+            __m128i mult_result = _mm_blendv_epi8(batch_1, batch_2, mask);
+            // Continue the algorithm normally, i.e
+            // (((input - mult_result) >> s1) + mult_result) >> s2
+            __m128i minus_result = _mm_sub_epi32(input, mult_result);
+            __m128i first_shift = _mm_srl_epi32(minus_result, s1);
+            __m128i add_result = _mm_add_epi32(first_shift, mult_result);
+            __m128i second_shift = _mm_srl_epi32(add_result, s2);
+            return second_shift;
+        }
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i divide_epu32(__m256i input, uint32_t multiplier, uint32_t shift_1, uint32_t shift_2)
+        {
+            __m256i m = _mm256_set1_epi32(multiplier);
+            __m128i s1 = _mm_setr_epi32(shift_1, 0, 0, 0);
+            __m128i s2 = _mm_setr_epi32(shift_2, 0, 0, 0);
+            // Multiply unsigned integers at positions 0, 2, 4 and 6 in n with the multiplier.
+            __m256i batch_1_unshifted = _mm256_mul_epu32(input, m);
+            // Store the high bits of the results.
+            __m256i batch_1 = _mm256_srli_epi64(batch_1_unshifted, 32);
+            // Shift the input in order to compute the product of the integers at odd positions.
+            __m256i n_shift = _mm256_srli_epi64(input, 32);
+            __m256i batch_2 = _mm256_mul_epu32(n_shift, m);
+            // Create a mask to extract the correct bits in the two batches.
+            __m256i mask = _mm256_set_epi32(-1, 0, -1, 0, -1, 0, -1, 0);
+            __m256i mult_result = _mm256_blendv_epi8(batch_1, batch_2, mask);
+            // Continue the algorithm normally, i.e
+            // (((input - mult_result) >> s1) + mult_result) >> s2
+            __m256i minus_result = _mm256_sub_epi32(input, mult_result);
+            __m256i first_shift = _mm256_srl_epi32(minus_result, s1);
+            __m256i add_result = _mm256_add_epi32(first_shift, mult_result);
+            __m256i second_shift = _mm256_srl_epi32(add_result, s2);
+            return second_shift;
+        }
+
+        inline FAST_DIVISION_TARGET_SSE41
+        __m128i divide_epi32(__m128i input, int32_t multiplier, int32_t shift, int32_t sign)
+        {
+            __m128i m = _mm_set1_epi32(multiplier);
+            __m128i s = _mm_setr_epi32(shift, 0, 0, 0);
+            __m128i sgn = _mm_set1_epi32(sign);
+            // Signed products of the integers at positions 0 and 2, high bits moved down.
+            __m128i batch_1 = _mm_srli_epi64(_mm_mul_epi32(input, m), 32);
+            // Signed products of the integers at positions 1 and 3, high bits already in place.
+            __m128i batch_2 = _mm_mul_epi32(_mm_srli_epi64(input, 32), m);
+            __m128i mult_result = _mm_blend_epi16(batch_1, batch_2, 0xCC);
+            // q = ((input + mult_result) >> s) - (input >> 31), i.e. add one for negative inputs.
+            __m128i add_result = _mm_add_epi32(input, mult_result);
+            __m128i shifted = _mm_sra_epi32(add_result, s);
+            __m128i q = _mm_sub_epi32(shifted, _mm_srai_epi32(input, 31));
+            // Negate for negative divisors: (q ^ sign) - sign.
+            return _mm_sub_epi32(_mm_xor_si128(q, sgn), sgn);
+        }
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i divide_epi32(__m256i input, int32_t multiplier, int32_t shift, int32_t sign)
+        {
+            __m256i m = _mm256_set1_epi32(multiplier);
+            __m128i s = _mm_setr_epi32(shift, 0, 0, 0);
+            __m256i sgn = _mm256_set1_epi32(sign);
+            // Signed products of the integers at even positions, high bits moved down.
+            __m256i batch_1 = _mm256_srli_epi64(_mm256_mul_epi32(input, m), 32);
+            // Signed products of the integers at odd positions, high bits already in place.
+            __m256i batch_2 = _mm256_mul_epi32(_mm256_srli_epi64(input, 32), m);
+            __m256i mult_result = _mm256_blend_epi32(batch_1, batch_2, 0xAA);
+            // q = ((input + mult_result) >> s) - (input >> 31), i.e. add one for negative inputs.
+            __m256i add_result = _mm256_add_epi32(input, mult_result);
+            __m256i shifted = _mm256_sra_epi32(add_result, s);
+            __m256i q = _mm256_sub_epi32(shifted, _mm256_srai_epi32(input, 31));
+            // Negate for negative divisors: (q ^ sign) - sign.
+            return _mm256_sub_epi32(_mm256_xor_si256(q, sgn), sgn);
+        }
+
+
+        inline FAST_DIVISION_TARGET_AVX512
+        __m512i divide_epu32(__m512i input, uint32_t multiplier, uint32_t shift_1, uint32_t shift_2)
+        {
+            __m512i m = _mm512_set1_epi32(int(multiplier));
+            __m128i s1 = _mm_setr_epi32(shift_1, 0, 0, 0);
+            __m128i s2 = _mm_setr_epi32(shift_2, 0, 0, 0);
+            // High bits of the products at even positions, moved down.
+            __m512i batch_1 = _mm512_srli_epi64(_mm512_mul_epu32(input, m), 32);
+            // High bits of the products at odd positions, already in place.
+            __m512i batch_2 = _mm512_mul_epu32(_mm512_srli_epi64(input, 32), m);
+            __m512i mult_result = _mm512_mask_blend_epi32(__mmask16(0xAAAA), batch_1, batch_2);
+            // (((input - mult_result) >> s1) + mult_result) >> s2
+            __m512i minus_result = _mm512_sub_epi32(input, mult_result);
+            __m512i first_shift = _mm512_srl_epi32(minus_result, s1);
+            __m512i add_result = _mm512_add_epi32(first_shift, mult_result);
+            return _mm512_srl_epi32(add_result, s2);
+        }
+
+        inline FAST_DIVISION_TARGET_AVX512
+        __m512i divide_epi32(__m512i input, int32_t multiplier, int32_t shift, int32_t sign)
+        {
+            __m512i m = _mm512_set1_epi32(multiplier);
+            __m128i s = _mm_setr_epi32(shift, 0, 0, 0);
+            __m512i sgn = _mm512_set1_epi32(sign);
+            __m512i batch_1 = _mm512_srli_epi64(_mm512_mul_epi32(input, m), 32);
+            __m512i batch_2 = _mm512_mul_epi32(_mm512_srli_epi64(input, 32), m);
+            __m512i mult_result = _mm512_mask_blend_epi32(__mmask16(0xAAAA), batch_1, batch_2);
+            __m512i add_result = _mm512_add_epi32(input, mult_result);
+            __m512i shifted = _mm512_sra_epi32(add_result, s);
+            __m512i q = _mm512_sub_epi32(shifted, _mm512_srai_epi32(input, 31));
+            return _mm512_sub_epi32(_mm512_xor_si512(q, sgn), sgn);
+        }
+
+        /// Branch-free unsigned division with a single shift, see branchfree_divider.hpp:
+        /// ((((input - t) >> 1) + t) >> shift) | (input & one_mask) with t the high product.
+
+        inline FAST_DIVISION_TARGET_SSE41
+        __m128i divide_branchfree_epu32(__m128i input, uint32_t multiplier, uint32_t shift, uint32_t one_mask)
+        {
+            __m128i m = _mm_set1_epi32(int(multiplier));
+            __m128i batch_1 = _mm_srli_epi64(_mm_mul_epu32(input, m), 32);
+            __m128i batch_2 = _mm_mul_epu32(_mm_srli_epi64(input, 32), m);
+            __m128i t = _mm_blend_epi16(batch_1, batch_2, 0xCC);
+            __m128i q = _mm_add_epi32(_mm_srli_epi32(_mm_sub_epi32(input, t), 1), t);
+            q = _mm_srl_epi32(q, _mm_setr_epi32(int(shift), 0, 0, 0));
+            return _mm_or_si128(q, _mm_and_si128(input, _mm_set1_epi32(int(one_mask))));
+        }
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i divide_branchfree_epu32(__m256i input, uint32_t multiplier, uint32_t shift, uint32_t one_mask)
+        {
+            __m256i m = _mm256_set1_epi32(int(multiplier));
+            __m256i batch_1 = _mm256_srli_epi64(_mm256_mul_epu32(input, m), 32);
+            __m256i batch_2 = _mm256_mul_epu32(_mm256_srli_epi64(input, 32), m);
+            __m256i t = _mm256_blend_epi32(batch_1, batch_2, 0xAA);
+            __m256i q = _mm256_add_epi32(_mm256_srli_epi32(_mm256_sub_epi32(input, t), 1), t);
+            q = _mm256_srl_epi32(q, _mm_setr_epi32(int(shift), 0, 0, 0));
+            return _mm256_or_si256(q, _mm256_and_si256(input, _mm256_set1_epi32(int(one_mask))));
+        }
+
+        inline FAST_DIVISION_TARGET_AVX512
+        __m512i divide_branchfree_epu32(__m512i input, uint32_t multiplier, uint32_t shift, uint32_t one_mask)
+        {
+            __m512i m = _mm512_set1_epi32(int(multiplier));
+            __m512i batch_1 = _mm512_srli_epi64(_mm512_mul_epu32(input, m), 32);
+            __m512i batch_2 = _mm512_mul_epu32(_mm512_srli_epi64(input, 32), m);
+            __m512i t = _mm512_mask_blend_epi32(__mmask16(0xAAAA), batch_1, batch_2);
+            __m512i q = _mm512_add_epi32(_mm512_srli_epi32(_mm512_sub_epi32(input, t), 1), t);
+            q = _mm512_srl_epi32(q, _mm_setr_epi32(int(shift), 0, 0, 0));
+            return _mm512_or_si512(q, _mm512_and_si512(input, _mm512_set1_epi32(int(one_mask))));
+        }
+
+        /// Per-lane variants of the branch-free kernels, where every lane has its own multiplier,
+        /// shift and mask, see divider_table.hpp. They need the variable shifts of AVX2.
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i divide_branchfree_epu32(__m256i input, __m256i multiplier, __m256i shift, __m256i one_mask)
+        {
+            // The odd lanes of the multiplier move down together with the odd lanes of the input.
+            __m256i batch_1 = _mm256_srli_epi64(_mm256_mul_epu32(input, multiplier), 32);
+            __m256i batch_2 = _mm256_mul_epu32(_mm256_srli_epi64(input, 32), _mm256_srli_epi64(multiplier, 32));
+            __m256i t = _mm256_blend_epi32(batch_1, batch_2, 0xAA);
+            __m256i q = _mm256_add_epi32(_mm256_srli_epi32(_mm256_sub_epi32(input, t), 1), t);
+            return _mm256_or_si256(_mm256_srlv_epi32(q, shift), _mm256_and_si256(input, one_mask));
+        }
+
+        inline FAST_DIVISION_TARGET_AVX512
+        __m512i divide_branchfree_epu32(__m512i input, __m512i multiplier, __m512i shift, __m512i one_mask)
+        {
+            __m512i batch_1 = _mm512_srli_epi64(_mm512_mul_epu32(input, multiplier), 32);
+            __m512i batch_2 = _mm512_mul_epu32(_mm512_srli_epi64(input, 32), _mm512_srli_epi64(multiplier, 32));
+            __m512i t = _mm512_mask_blend_epi32(__mmask16(0xAAAA), batch_1, batch_2);
+            __m512i q = _mm512_add_epi32(_mm512_srli_epi32(_mm512_sub_epi32(input, t), 1), t);
+            return _mm512_or_si512(_mm512_srlv_epi32(q, shift), _mm512_and_si512(input, one_mask));
+        }
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i divide_epi32(__m256i input, __m256i multiplier, __m256i shift, __m256i sign)
+        {
+            __m256i batch_1 = _mm256_srli_epi64(_mm256_mul_epi32(input, multiplier), 32);
+            __m256i batch_2 = _mm256_mul_epi32(_mm256_srli_epi64(input, 32), _mm256_srli_epi64(multiplier, 32));
+            __m256i mult_result = _mm256_blend_epi32(batch_1, batch_2, 0xAA);
+            __m256i shifted = _mm256_srav_epi32(_mm256_add_epi32(input, mult_result), shift);
+            __m256i q = _mm256_sub_epi32(shifted, _mm256_srai_epi32(input, 31));
+            return _mm256_sub_epi32(_mm256_xor_si256(q, sign), sign);
+        }
+
+        inline FAST_DIVISION_TARGET_AVX512
+        __m512i divide_epi32(__m512i input, __m512i multiplier, __m512i shift, __m512i sign)
+        {
+            __m512i batch_1 = _mm512_srli_epi64(_mm512_mul_epi32(input, multiplier), 32);
+            __m512i batch_2 = _mm512_mul_epi32(_mm512_srli_epi64(input, 32), _mm512_srli_epi64(multiplier, 32));
+            __m512i mult_result = _mm512_mask_blend_epi32(__mmask16(0xAAAA), batch_1, batch_2);
+            __m512i shifted = _mm512_srav_epi32(_mm512_add_epi32(input, mult_result), shift);
+            __m512i q = _mm512_sub_epi32(shifted, _mm512_srai_epi32(input, 31));
+            return _mm512_sub_epi32(_mm512_xor_si512(q, sign), sign);
+        }
+
+        /// 16-bit lanes have native high multiplications, so the sequences above need a single
+        /// multiplication per vector. The 128-bit kernels only use SSE2, which every x86-64
+        /// processor has. AVX-512F has no 16-bit arithmetic (that is AVX-512BW), so the 512-bit
+        /// kernels divide the two 256-bit halves.
+
+        inline
+        __m128i divide_epu16(__m128i input, uint16_t multiplier, uint16_t shift_1, uint16_t shift_2)
+        {
+            __m128i t = _mm_mulhi_epu16(input, _mm_set1_epi16(short(multiplier)));
+            __m128i first_shift = _mm_srl_epi16(_mm_sub_epi16(input, t), _mm_cvtsi32_si128(shift_1));
+            return _mm_srl_epi16(_mm_add_epi16(first_shift, t), _mm_cvtsi32_si128(shift_2));
+        }
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i divide_epu16(__m256i input, uint16_t multiplier, uint16_t shift_1, uint16_t shift_2)
+        {
+            __m256i t = _mm256_mulhi_epu16(input, _mm256_set1_epi16(short(multiplier)));
+            __m256i first_shift = _mm256_srl_epi16(_mm256_sub_epi16(input, t), _mm_cvtsi32_si128(shift_1));
+            return _mm256_srl_epi16(_mm256_add_epi16(first_shift, t), _mm_cvtsi32_si128(shift_2));
+        }
+
+        inline
+        __m128i divide_epi16(__m128i input, int16_t multiplier, int16_t shift, int16_t sign)
+        {
+            __m128i sgn = _mm_set1_epi16(sign);
+            __m128i t = _mm_mulhi_epi16(input, _mm_set1_epi16(multiplier));
+            __m128i shifted = _mm_sra_epi16(_mm_add_epi16(input, t), _mm_cvtsi32_si128(shift));
+            __m128i q = _mm_sub_epi16(shifted, _mm_srai_epi16(input, 15));
+            return _mm_sub_epi16(_mm_xor_si128(q, sgn), sgn);
+        }
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i divide_epi16(__m256i input, int16_t multiplier, int16_t shift, int16_t sign)
+        {
+            __m256i sgn = _mm256_set1_epi16(sign);
+            __m256i t = _mm256_mulhi_epi16(input, _mm256_set1_epi16(multiplier));
+            __m256i shifted = _mm256_sra_epi16(_mm256_add_epi16(input, t), _mm_cvtsi32_si128(shift));
+            __m256i q = _mm256_sub_epi16(shifted, _mm256_srai_epi16(input, 15));
+            return _mm256_sub_epi16(_mm256_xor_si256(q, sgn), sgn);
+        }
+
+        /// 8-bit lanes have no multiplication at all. The bytes are widened to 16-bit lanes, where
+        /// the product of the input and the 8-bit multiplier fits in the low half, and packed back.
+        /// Unpacking and packing both work within 128-bit lanes, so the order is preserved.
+
+        inline
+        __m128i divide_widened_epu8(__m128i input, __m128i multiplier, __m128i shift_1, __m128i shift_2)
+        {
+            __m128i t = _mm_srli_epi16(_mm_mullo_epi16(input, multiplier), 8);
+            __m128i first_shift = _mm_srl_epi16(_mm_sub_epi16(input, t), shift_1);
+            return _mm_srl_epi16(_mm_add_epi16(first_shift, t), shift_2);
+        }
+
+        inline
+        __m128i divide_epu8(__m128i input, uint8_t multiplier, uint8_t shift_1, uint8_t shift_2)
+        {
+            __m128i zero = _mm_setzero_si128();
+            __m128i m = _mm_set1_epi16(short(multiplier));
+            __m128i s1 = _mm_cvtsi32_si128(shift_1);
+            __m128i s2 = _mm_cvtsi32_si128(shift_2);
+            __m128i low = divide_widened_epu8(_mm_unpacklo_epi8(input, zero), m, s1, s2);
+            __m128i high = divide_widened_epu8(_mm_unpackhi_epi8(input, zero), m, s1, s2);
+            return _mm_packus_epi16(low, high);
+        }
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i divide_widened_epu8(__m256i input, __m256i multiplier, __m128i shift_1, __m128i shift_2)
+        {
+            __m256i t = _mm256_srli_epi16(_mm256_mullo_epi16(input, multiplier), 8);
+            __m256i first_shift = _mm256_srl_epi16(_mm256_sub_epi16(input, t), shift_1);
+            return _mm256_srl_epi16(_mm256_add_epi16(first_shift, t), shift_2);
+        }
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i divide_epu8(__m256i input, uint8_t multiplier, uint8_t shift_1, uint8_t shift_2)
+        {
+            __m256i zero = _mm256_setzero_si256();
+            __m256i m = _mm256_set1_epi16(short(multiplier));
+            __m128i s1 = _mm_cvtsi32_si128(shift_1);
+            __m128i s2 = _mm_cvtsi32_si128(shift_2);
+            __m256i low = divide_widened_epu8(_mm256_unpacklo_epi8(input, zero), m, s1, s2);
+            __m256i high = divide_widened_epu8(_mm256_unpackhi_epi8(input, zero), m, s1, s2);
+            return _mm256_packus_epi16(low, high);
+        }
+
+        inline
+        __m128i divide_widened_epi8(__m128i input, __m128i multiplier, __m128i shift)
+        {
+            __m128i t = _mm_srai_epi16(_mm_mullo_epi16(input, multiplier), 8);
+            __m128i shifted = _mm_sra_epi16(_mm_add_epi16(input, t), shift);
+            return _mm_sub_epi16(shifted, _mm_srai_epi16(input, 15));
+        }
+
+        inline
+        __m128i divide_epi8(__m128i input, int8_t multiplier, int8_t shift, int8_t sign)
+        {
+            __m128i m = _mm_set1_epi16(multiplier);
+            __m128i s = _mm_cvtsi32_si128(shift);
+            __m128i sgn = _mm_set1_epi8(sign);
+            // Sign extend by moving each byte to the high half and shifting it back.
+            __m128i low = divide_widened_epi8(_mm_srai_epi16(_mm_unpacklo_epi8(input, input), 8), m, s);
+            __m128i high = divide_widened_epi8(_mm_srai_epi16(_mm_unpackhi_epi8(input, input), 8), m, s);
+            // Keep the low bytes instead of saturating, so that min / -1 wraps like the scalar division.
+            __m128i byte_mask = _mm_set1_epi16(0xFF);
+            __m128i q = _mm_packus_epi16(_mm_and_si128(low, byte_mask), _mm_and_si128(high, byte_mask));
+            return _mm_sub_epi8(_mm_xor_si128(q, sgn), sgn);
+        }
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i divide_widened_epi8(__m256i input, __m256i multiplier, __m128i shift)
+        {
+            __m256i t = _mm256_srai_epi16(_mm256_mullo_epi16(input, multiplier), 8);
+            __m256i shifted = _mm256_sra_epi16(_mm256_add_epi16(input, t), shift);
+            return _mm256_sub_epi16(shifted, _mm256_srai_epi16(input, 15));
+        }
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i divide_epi8(__m256i input, int8_t multiplier, int8_t shift, int8_t sign)
+        {
+            __m256i m = _mm256_set1_epi16(multiplier);
+            __m128i s = _mm_cvtsi32_si128(shift);
+            __m256i sgn = _mm256_set1_epi8(sign);
+            __m256i low = divide_widened_epi8(_mm256_srai_epi16(_mm256_unpacklo_epi8(input, input), 8), m, s);
+            __m256i high = divide_widened_epi8(_mm256_srai_epi16(_mm256_unpackhi_epi8(input, input), 8), m, s);
+            __m256i byte_mask = _mm256_set1_epi16(0xFF);
+            __m256i q = _mm256_packus_epi16(_mm256_and_si256(low, byte_mask), _mm256_and_si256(high, byte_mask));
+            return _mm256_sub_epi8(_mm256_xor_si256(q, sgn), sgn);
+        }
+
+        /// The 512-bit 8- and 16-bit kernels, one 256-bit half at a time.
+
+        inline FAST_DIVISION_TARGET_AVX512
+        __m512i join_halves(__m256i low, __m256i high)
+        {
+            return _mm512_inserti64x4(_mm512_castsi256_si512(low), high, 1);
+        }
+
+        inline FAST_DIVISION_TARGET_AVX512
+        __m512i divide_epu16(__m512i input, uint16_t multiplier, uint16_t shift_1, uint16_t shift_2)
+        {
+            return join_halves(divide_epu16(_mm512_castsi512_si256(input), multiplier, shift_1, shift_2),
+                               divide_epu16(_mm512_extracti64x4_epi64(input, 1), multiplier, shift_1, shift_2));
+        }
+
+        inline FAST_DIVISION_TARGET_AVX512
+        __m512i divide_epi16(__m512i input, int16_t multiplier, int16_t shift, int16_t sign)
+        {
+            return join_halves(divide_epi16(_mm512_castsi512_si256(input), multiplier, shift, sign),
+                               divide_epi16(_mm512_extracti64x4_epi64(input, 1), multiplier, shift, sign));
+        }
+
+        inline FAST_DIVISION_TARGET_AVX512
+        __m512i divide_epu8(__m512i input, uint8_t multiplier, uint8_t shift_1, uint8_t shift_2)
+        {
+            return join_halves(divide_epu8(_mm512_castsi512_si256(input), multiplier, shift_1, shift_2),
+                               divide_epu8(_mm512_extracti64x4_epi64(input, 1), multiplier, shift_1, shift_2));
+        }
+
+        inline FAST_DIVISION_TARGET_AVX512
+        __m512i divide_epi8(__m512i input, int8_t multiplier, int8_t shift, int8_t sign)
+        {
+            return join_halves(divide_epi8(_mm512_castsi512_si256(input), multiplier, shift, sign),
+                               divide_epi8(_mm512_extracti64x4_epi64(input, 1), multiplier, shift, sign));
+        }
+
+        /// input - quotient * divisor in every lane, i.e. the remainder of a truncating division.
+        /// The low half of the product is the same for signed and unsigned lanes.
+
+        inline FAST_DIVISION_TARGET_SSE41
+        __m128i subtract_product_epi32(__m128i input, __m128i quotient, uint32_t divisor)
+        {
+            return _mm_sub_epi32(input, _mm_mullo_epi32(quotient, _mm_set1_epi32(int(divisor))));
+        }
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i subtract_product_epi32(__m256i input, __m256i quotient, uint32_t divisor)
+        {
+            return _mm256_sub_epi32(input, _mm256_mullo_epi32(quotient, _mm256_set1_epi32(int(divisor))));
+        }
+
+        inline FAST_DIVISION_TARGET_AVX512
+        __m512i subtract_product_epi32(__m512i input, __m512i quotient, uint32_t divisor)
+        {
+            return _mm512_sub_epi32(input, _mm512_mullo_epi32(quotient, _mm512_set1_epi32(int(divisor))));
+        }
+
+        inline
+        __m128i subtract_product_epi16(__m128i input, __m128i quotient, uint16_t divisor)
+        {
+            return _mm_sub_epi16(input, _mm_mullo_epi16(quotient, _mm_set1_epi16(short(divisor))));
+        }
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i subtract_product_epi16(__m256i input, __m256i quotient, uint16_t divisor)
+        {
+            return _mm256_sub_epi16(input, _mm256_mullo_epi16(quotient, _mm256_set1_epi16(short(divisor))));
+        }
+
+        inline FAST_DIVISION_TARGET_AVX512
+        __m512i subtract_product_epi16(__m512i input, __m512i quotient, uint16_t divisor)
+        {
+            return join_halves(
+                subtract_product_epi16(_mm512_castsi512_si256(input), _mm512_castsi512_si256(quotient), divisor),
+                subtract_product_epi16(_mm512_extracti64x4_epi64(input, 1), _mm512_extracti64x4_epi64(quotient, 1), divisor));
+        }
+
+        /// Bytes are multiplied as the even and the odd bytes of 16-bit lanes.
+
+        inline
+        __m128i subtract_product_epi8(__m128i input, __m128i quotient, uint8_t divisor)
+        {
+            __m128i d = _mm_set1_epi16(short(divisor));
+            __m128i even = _mm_and_si128(_mm_mullo_epi16(quotient, d), _mm_set1_epi16(0xFF));
+            __m128i odd = _mm_slli_epi16(_mm_mullo_epi16(_mm_srli_epi16(quotient, 8), d), 8);
+            return _mm_sub_epi8(input, _mm_or_si128(even, odd));
+        }
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i subtract_product_epi8(__m256i input, __m256i quotient, uint8_t divisor)
+        {
+            __m256i d = _mm256_set1_epi16(short(divisor));
+            __m256i even = _mm256_and_si256(_mm256_mullo_epi16(quotient, d), _mm256_set1_epi16(0xFF));
+            __m256i odd = _mm256_slli_epi16(_mm256_mullo_epi16(_mm256_srli_epi16(quotient, 8), d), 8);
+            return _mm256_sub_epi8(input, _mm256_or_si256(even, odd));
+        }
+
+        inline FAST_DIVISION_TARGET_AVX512
+        __m512i subtract_product_epi8(__m512i input, __m512i quotient, uint8_t divisor)
+        {
+            return join_halves(
+                subtract_product_epi8(_mm512_castsi512_si256(input), _mm512_castsi512_si256(quotient), divisor),
+                subtract_product_epi8(_mm512_extracti64x4_epi64(input, 1), _mm512_extracti64x4_epi64(quotient, 1), divisor));
+        }
+
+        /// Exact division of multiples: shift out the power of two, multiply by the inverse of
+        /// the odd part modulo 2^32 and apply the divisor sign.
+
+        inline FAST_DIVISION_TARGET_SSE41
+        __m128i exact_divide_epu32(__m128i input, uint32_t inverse, uint32_t shift)
+        {
+            __m128i shifted = _mm_srl_epi32(input, _mm_setr_epi32(shift, 0, 0, 0));
+            return _mm_mullo_epi32(shifted, _mm_set1_epi32(int(inverse)));
+        }
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i exact_divide_epu32(__m256i input, uint32_t inverse, uint32_t shift)
+        {
+            __m256i shifted = _mm256_srl_epi32(input, _mm_setr_epi32(shift, 0, 0, 0));
+            return _mm256_mullo_epi32(shifted, _mm256_set1_epi32(int(inverse)));
+        }
+
+        inline FAST_DIVISION_TARGET_SSE41
+        __m128i exact_divide_epi32(__m128i input, uint32_t inverse, uint32_t shift, int32_t sign)
+        {
+            __m128i sgn = _mm_set1_epi32(sign);
+            __m128i shifted = _mm_sra_epi32(input, _mm_setr_epi32(shift, 0, 0, 0));
+            __m128i q = _mm_mullo_epi32(shifted, _mm_set1_epi32(int(inverse)));
+            return _mm_sub_epi32(_mm_xor_si128(q, sgn), sgn);
+        }
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i exact_divide_epi32(__m256i input, uint32_t inverse, uint32_t shift, int32_t sign)
+        {
+            __m256i sgn = _mm256_set1_epi32(sign);
+            __m256i shifted = _mm256_sra_epi32(input, _mm_setr_epi32(shift, 0, 0, 0));
+            __m256i q = _mm256_mullo_epi32(shifted, _mm256_set1_epi32(int(inverse)));
+            return _mm256_sub_epi32(_mm256_xor_si256(q, sgn), sgn);
+        }
+
+        /// Divisibility: rotate input * inverse right by shift and compare against the limit.
+        /// A shift count of 32 clears the lane, so a zero shift needs no special case.
+
+        inline FAST_DIVISION_TARGET_SSE41
+        __m128i divisible_epu32(__m128i input, uint32_t inverse, uint32_t shift, uint32_t limit)
+        {
+            __m128i x = _mm_mullo_epi32(input, _mm_set1_epi32(int(inverse)));
+            __m128i rotated = _mm_or_si128(_mm_srl_epi32(x, _mm_setr_epi32(shift, 0, 0, 0)),
+                                           _mm_sll_epi32(x, _mm_setr_epi32(32 - shift, 0, 0, 0)));
+            return _mm_cmpeq_epi32(_mm_min_epu32(rotated, _mm_set1_epi32(int(limit))), rotated);
+        }
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i divisible_epu32(__m256i input, uint32_t inverse, uint32_t shift, uint32_t limit)
+        {
+            __m256i x = _mm256_mullo_epi32(input, _mm256_set1_epi32(int(inverse)));
+            __m256i rotated = _mm256_or_si256(_mm256_srl_epi32(x, _mm_setr_epi32(shift, 0, 0, 0)),
+                                              _mm256_sll_epi32(x, _mm_setr_epi32(32 - shift, 0, 0, 0)));
+            return _mm256_cmpeq_epi32(_mm256_min_epu32(rotated, _mm256_set1_epi32(int(limit))), rotated);
+        }
+
+        /// The remainder kernels above by the width of the divisor, one overload per vector width
+        /// with the target of that width, so that vectors are passed in registers of that width.
+
+        template <typename Integer>
+        inline FAST_DIVISION_TARGET_SSE41
+        __m128i subtract_product(__m128i input, __m128i quotient, Integer divisor)
+        {
+            static_assert(sizeof(Integer) <= 4, "Vector remainders have 8, 16 or 32-bit lanes");
+            return sizeof(Integer) == 4 ? subtract_product_epi32(input, quotient, uint32_t(divisor)) :
+                   sizeof(Integer) == 2 ? subtract_product_epi16(input, quotient, uint16_t(divisor)) :
+                                          subtract_product_epi8(input, quotient, uint8_t(divisor));
+        }
+
+        template <typename Integer>
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i subtract_product(__m256i input, __m256i quotient, Integer divisor)
+        {
+            static_assert(sizeof(Integer) <= 4, "Vector remainders have 8, 16 or 32-bit lanes");
+            return sizeof(Integer) == 4 ? subtract_product_epi32(input, quotient, uint32_t(divisor)) :
+                   sizeof(Integer) == 2 ? subtract_product_epi16(input, quotient, uint16_t(divisor)) :
+                                          subtract_product_epi8(input, quotient, uint8_t(divisor));
+        }
+
+        template <typename Integer>
+        inline FAST_DIVISION_TARGET_AVX512
+        __m512i subtract_product(__m512i input, __m512i quotient, Integer divisor)
+        {
+            static_assert(sizeof(Integer) <= 4, "Vector remainders have 8, 16 or 32-bit lanes");
+            return sizeof(Integer) == 4 ? subtract_product_epi32(input, quotient, uint32_t(divisor)) :
+                   sizeof(Integer) == 2 ? subtract_product_epi16(input, quotient, uint16_t(divisor)) :
+                                          subtract_product_epi8(input, quotient, uint8_t(divisor));
+        }
+
+    }
+
     /// Specializations for various simd types.
+
     template<> template<>
-    inline
+    inline FAST_DIVISION_TARGET_SSE41
     __m128i constant_divider_base<uint32_t, false, promotion_policy>::operator()<> (__m128i input) const
     {
-        __m128i m = _mm_set1_epi32(multiplier_);
-        __m128i s1 = _mm_setr_epi32(shift_1_, 0, 0, 0);
-        __m128i s2 = _mm_setr_epi32(shift_2_, 0, 0, 0);
-        // Multiply unsigned integers at positions 0 and 2 in n with the multiplier.
-        __m128i batch_1_unshifted = _mm_mul_epu32(input, m);
-        // Store the high bits of the results.
-        __m128i batch_1 = _mm_srli_epi64(batch_1_unshifted, 32);
-        // Shift the input in order to compute the product of the integers at positions 1 and 3.
-        __m128i n_shift = _mm_srli_epi64(input, 32);
-        __m128i batch_2 = _mm_mul_epu32(n_shift, m);
-        // Create a mask to extract the correct bits in the two batches.
-        __m128i mask = _mm_set_epi32(-1, 0, -1, 0);
-        __m128i mult_result = _mm_blendv_epi8(batch_1, batch_2, mask);
-        // Continue the algorithm normally, i.e
-        // (((input - mult_result) >> s1) + mult_result) >> s2
-        __m128i minus_result = _mm_sub_epi32(input, mult_result);
-        __m128i first_shift = _mm_srl_epi32(minus_result, s1);
-        __m128i add_result = _mm_add_epi32(first_shift, mult_result);
-        __m128i second_shift = _mm_srl_epi32(add_result, s2);
-        return second_shift;
+        return detail::divide_epu32(input, multiplier_, shift_1_, shift_2_);
     }
 
     template<> template<>
-    inline
+    inline FAST_DIVISION_TARGET_AVX2
     __m256i constant_divider_base<uint32_t, false, promotion_policy>::operator()<> (__m256i input) const
     {
-        __m256i m = _mm256_set1_epi32(multiplier_);
-        __m128i s1 = _mm_setr_epi32(shift_1_, 0, 0, 0);
-        __m128i s2 = _mm_setr_epi32(shift_2_, 0, 0, 0);
-        // Multiply unsigned integers at positions 0 and 2 in n with the multiplier.
-        __m256i batch_1_unshifted = _mm256_mul_epu32(input, m);
-        // Store the high bits of the results.
-        __m256i batch_1 = _mm256_srli_epi64(batch_1_unshifted, 32);
-        // Shift the input in order to compute the product of the integers at positions 1 and 3.
-        __m256i n_shift = _mm256_srli_epi64(input, 32);
-        __m256i batch_2 = _mm256_mul_epu32(n_shift, m);
-        // Create a mask to extract the correct bits in the two batches.
-        __m256i mask = _mm256_set_epi32(-1, 0, -1, 0, -1, 0, 0, 1);
-        __m256i mult_result = _mm256_blendv_epi8(batch_1, batch_2, mask);
-        // Continue the algorithm normally, i.e
-        // (((input - mult_result) >> s1) + mult_result) >> s2
-        __m256i minus_result = _mm256_sub_epi32(input, mult_result);
-        __m256i first_shift = _mm256_srl_epi32(minus_result, s1);
-        __m256i add_result = _mm256_add_epi32(first_shift, mult_result);
-        __m256i second_shift = _mm256_srl_epi32(add_result, s2);
-        return second_shift;
-    }
-
-    template <typename Integer, template <typename, bool> class P, typename Simd, typename = std::enable_if_t<utility::is_simd<Simd>>>
+        return detail::divide_epu32(input, multiplier_, shift_1_, shift_2_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX512
+    __m512i constant_divider_base<uint32_t, false, promotion_policy>::operator()<> (__m512i input) const
+    {
+        return detail::divide_epu32(input, multiplier_, shift_1_, shift_2_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_SSE41
+    __m128i constant_divider_base<uint32_t, false, decomposition_policy>::operator()<> (__m128i input) const
+    {
+        return detail::divide_epu32(input, multiplier_, shift_1_, shift_2_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX2
+    __m256i constant_divider_base<uint32_t, false, decomposition_policy>::operator()<> (__m256i input) const
+    {
+        return detail::divide_epu32(input, multiplier_, shift_1_, shift_2_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX512
+    __m512i constant_divider_base<uint32_t, false, decomposition_policy>::operator()<> (__m512i input) const
+    {
+        return detail::divide_epu32(input, multiplier_, shift_1_, shift_2_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_SSE41
+    __m128i constant_divider_base<int32_t, true, promotion_policy>::operator()<> (__m128i input) const
+    {
+        return detail::divide_epi32(input, multiplier_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX2
+    __m256i constant_divider_base<int32_t, true, promotion_policy>::operator()<> (__m256i input) const
+    {
+        return detail::divide_epi32(input, multiplier_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX512
+    __m512i constant_divider_base<int32_t, true, promotion_policy>::operator()<> (__m512i input) const
+    {
+        return detail::divide_epi32(input, multiplier_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_SSE41
+    __m128i constant_divider_base<int32_t, true, decomposition_policy>::operator()<> (__m128i input) const
+    {
+        return detail::divide_epi32(input, multiplier_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX2
+    __m256i constant_divider_base<int32_t, true, decomposition_policy>::operator()<> (__m256i input) const
+    {
+        return detail::divide_epi32(input, multiplier_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX512
+    __m512i constant_divider_base<int32_t, true, decomposition_policy>::operator()<> (__m512i input) const
+    {
+        return detail::divide_epi32(input, multiplier_, shift_, sign_);
+    }
+
+    /// 8- and 16-bit lanes.
+    template<> template<>
+    inline
+    __m128i constant_divider_base<uint16_t, false, promotion_policy>::operator()<> (__m128i input) const
+    {
+        return detail::divide_epu16(input, multiplier_, shift_1_, shift_2_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX2
+    __m256i constant_divider_base<uint16_t, false, promotion_policy>::operator()<> (__m256i input) const
+    {
+        return detail::divide_epu16(input, multiplier_, shift_1_, shift_2_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX512
+    __m512i constant_divider_base<uint16_t, false, promotion_policy>::operator()<> (__m512i input) const
+    {
+        return detail::divide_epu16(input, multiplier_, shift_1_, shift_2_);
+    }
+
+    template<> template<>
+    inline
+    __m128i constant_divider_base<uint16_t, false, decomposition_policy>::operator()<> (__m128i input) const
+    {
+        return detail::divide_epu16(input, multiplier_, shift_1_, shift_2_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX2
+    __m256i constant_divider_base<uint16_t, false, decomposition_policy>::operator()<> (__m256i input) const
+    {
+        return detail::divide_epu16(input, multiplier_, shift_1_, shift_2_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX512
+    __m512i constant_divider_base<uint16_t, false, decomposition_policy>::operator()<> (__m512i input) const
+    {
+        return detail::divide_epu16(input, multiplier_, shift_1_, shift_2_);
+    }
+
+    template<> template<>
+    inline
+    __m128i constant_divider_base<int16_t, true, promotion_policy>::operator()<> (__m128i input) const
+    {
+        return detail::divide_epi16(input, multiplier_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX2
+    __m256i constant_divider_base<int16_t, true, promotion_policy>::operator()<> (__m256i input) const
+    {
+        return detail::divide_epi16(input, multiplier_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX512
+    __m512i constant_divider_base<int16_t, true, promotion_policy>::operator()<> (__m512i input) const
+    {
+        return detail::divide_epi16(input, multiplier_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline
+    __m128i constant_divider_base<int16_t, true, decomposition_policy>::operator()<> (__m128i input) const
+    {
+        return detail::divide_epi16(input, multiplier_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX2
+    __m256i constant_divider_base<int16_t, true, decomposition_policy>::operator()<> (__m256i input) const
+    {
+        return detail::divide_epi16(input, multiplier_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX512
+    __m512i constant_divider_base<int16_t, true, decomposition_policy>::operator()<> (__m512i input) const
+    {
+        return detail::divide_epi16(input, multiplier_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline
+    __m128i constant_divider_base<uint8_t, false, promotion_policy>::operator()<> (__m128i input) const
+    {
+        return detail::divide_epu8(input, multiplier_, shift_1_, shift_2_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX2
+    __m256i constant_divider_base<uint8_t, false, promotion_policy>::operator()<> (__m256i input) const
+    {
+        return detail::divide_epu8(input, multiplier_, shift_1_, shift_2_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX512
+    __m512i constant_divider_base<uint8_t, false, promotion_policy>::operator()<> (__m512i input) const
+    {
+        return detail::divide_epu8(input, multiplier_, shift_1_, shift_2_);
+    }
+
+    template<> template<>
+    inline
+    __m128i constant_divider_base<uint8_t, false, decomposition_policy>::operator()<> (__m128i input) const
+    {
+        return detail::divide_epu8(input, multiplier_, shift_1_, shift_2_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX2
+    __m256i constant_divider_base<uint8_t, false, decomposition_policy>::operator()<> (__m256i input) const
+    {
+        return detail::divide_epu8(input, multiplier_, shift_1_, shift_2_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX512
+    __m512i constant_divider_base<uint8_t, false, decomposition_policy>::operator()<> (__m512i input) const
+    {
+        return detail::divide_epu8(input, multiplier_, shift_1_, shift_2_);
+    }
+
+    template<> template<>
+    inline
+    __m128i constant_divider_base<int8_t, true, promotion_policy>::operator()<> (__m128i input) const
+    {
+        return detail::divide_epi8(input, multiplier_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX2
+    __m256i constant_divider_base<int8_t, true, promotion_policy>::operator()<> (__m256i input) const
+    {
+        return detail::divide_epi8(input, multiplier_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX512
+    __m512i constant_divider_base<int8_t, true, promotion_policy>::operator()<> (__m512i input) const
+    {
+        return detail::divide_epi8(input, multiplier_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline
+    __m128i constant_divider_base<int8_t, true, decomposition_policy>::operator()<> (__m128i input) const
+    {
+        return detail::divide_epi8(input, multiplier_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX2
+    __m256i constant_divider_base<int8_t, true, decomposition_policy>::operator()<> (__m256i input) const
+    {
+        return detail::divide_epi8(input, multiplier_, shift_, sign_);
+    }
+
+    template<> template<>
+    inline FAST_DIVISION_TARGET_AVX512
+    __m512i constant_divider_base<int8_t, true, decomposition_policy>::operator()<> (__m512i input) const
+    {
+        return detail::divide_epi8(input, multiplier_, shift_, sign_);
+    }
+
+    /// Whether the SIMD specializations above exist for a divider type.
+
+    template <typename Integer, template <typename, bool> class DivisionPolicy>
+    struct has_simd_kernels : std::false_type {};
+
+    template <>
+    struct has_simd_kernels<uint32_t, promotion_policy> : std::true_type {};
+
+    template <>
+    struct has_simd_kernels<uint32_t, decomposition_policy> : std::true_type {};
+
+    template <>
+    struct has_simd_kernels<int32_t, promotion_policy> : std::true_type {};
+
+    template <>
+    struct has_simd_kernels<int32_t, decomposition_policy> : std::true_type {};
+
+    template <>
+    struct has_simd_kernels<uint16_t, promotion_policy> : std::true_type {};
+
+    template <>
+    struct has_simd_kernels<uint16_t, decomposition_policy> : std::true_type {};
+
+    template <>
+    struct has_simd_kernels<int16_t, promotion_policy> : std::true_type {};
+
+    template <>
+    struct has_simd_kernels<int16_t, decomposition_policy> : std::true_type {};
+
+    template <>
+    struct has_simd_kernels<uint8_t, promotion_policy> : std::true_type {};
+
+    template <>
+    struct has_simd_kernels<uint8_t, decomposition_policy> : std::true_type {};
+
+    template <>
+    struct has_simd_kernels<int8_t, promotion_policy> : std::true_type {};
+
+    template <>
+    struct has_simd_kernels<int8_t, decomposition_policy> : std::true_type {};
+
+    template <typename Integer, template <typename, bool> class P, typename Simd, typename = std::enable_if_t<utility::is_simd<Simd>::value>>
     inline
     Simd operator/ (Simd divident, const constant_divider_base<Integer, std::is_signed<Integer>::value, P>& divisor)
     {
         return divisor(divident);
     }
 
-}
\ No newline at end of file
+}
+
+FAST_DIVISION_AVX512_WARNINGS_POP
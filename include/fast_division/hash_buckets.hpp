@@ -0,0 +1,460 @@
+/**
+ *  Fast Division Library
+ *  Created by Stefan Ivanov
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <immintrin.h>
+
+#include <fast_division/fast_division.hpp>
+#include <fast_division/fast_division_dispatch.hpp>
+#include <fast_division/fast_division_simd.hpp>
+#include <fast_division/utility/log2i.hpp>
+
+namespace fast_division {
+
+    namespace detail {
+
+        /// Primes close to powers of two, each about twice the previous one, so that tables
+        /// grow geometrically and the bucket count shares no factor with common strides.
+        constexpr uint32_t bucket_primes[] = {
+            3u, 7u, 13u, 29u, 53u, 97u, 193u, 389u, 769u, 1543u, 3079u, 6151u, 12289u, 24593u,
+            49157u, 98317u, 196613u, 393241u, 786433u, 1572869u, 3145739u, 6291469u, 12582917u,
+            25165843u, 50331653u, 100663319u, 201326611u, 402653189u, 805306457u, 1610612741u,
+            3221225473u, 4294967291u
+        };
+
+        constexpr std::size_t num_bucket_primes = sizeof(bucket_primes) / sizeof(bucket_primes[0]);
+
+        template <typename Integer, template <typename I, bool S> class DivisionPolicy, std::size_t... Indices>
+        constexpr std::array<constant_divider<Integer, DivisionPolicy>, sizeof...(Indices)>
+        make_bucket_dividers(std::index_sequence<Indices...>)
+        {
+            return { { constant_divider<Integer, DivisionPolicy>(Integer(bucket_primes[Indices]))... } };
+        }
+
+        /// Remainders of whole arrays, with the same structure as the bulk division kernels. Like
+        /// those, they call the kernels of the base, which carry the target of their width, and
+        /// are counted once per array by remainder_array.
+
+        template <typename Integer, template <typename I, bool S> class DivisionPolicy>
+        inline
+        void remainder_array_scalar(const constant_divider<Integer, DivisionPolicy>& divider,
+                                    const Integer* input, Integer* output, std::size_t size)
+        {
+            for (std::size_t i = 0; i != size; ++i) {
+                output[i] = divider.constants().remainder(input[i], divider.divisor());
+            }
+        }
+
+        template <typename Integer, template <typename I, bool S> class DivisionPolicy>
+        inline FAST_DIVISION_TARGET_SSE41
+        void remainder_array_sse41(const constant_divider<Integer, DivisionPolicy>& divider,
+                                   const Integer* input, Integer* output, std::size_t size)
+        {
+            constexpr std::size_t lanes = sizeof(__m128i) / sizeof(Integer);
+            std::size_t i = 0;
+            for (; i + lanes <= size; i += lanes) {
+                __m128i n = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+                __m128i r = subtract_product(n, divider.constants()(n), divider.divisor());
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), r);
+            }
+            remainder_array_scalar(divider, input + i, output + i, size - i);
+        }
+
+        template <typename Integer, template <typename I, bool S> class DivisionPolicy>
+        inline FAST_DIVISION_TARGET_AVX2
+        void remainder_array_avx2(const constant_divider<Integer, DivisionPolicy>& divider,
+                                  const Integer* input, Integer* output, std::size_t size)
+        {
+            constexpr std::size_t lanes = sizeof(__m256i) / sizeof(Integer);
+            std::size_t i = 0;
+            for (; i + lanes <= size; i += lanes) {
+                __m256i n = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+                __m256i r = subtract_product(n, divider.constants()(n), divider.divisor());
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), r);
+            }
+            remainder_array_scalar(divider, input + i, output + i, size - i);
+        }
+
+        template <typename Integer, template <typename I, bool S> class DivisionPolicy>
+        inline FAST_DIVISION_TARGET_AVX512
+        void remainder_array_avx512(const constant_divider<Integer, DivisionPolicy>& divider,
+                                    const Integer* input, Integer* output, std::size_t size)
+        {
+            constexpr std::size_t lanes = sizeof(__m512i) / sizeof(Integer);
+            std::size_t i = 0;
+            for (; i + lanes <= size; i += lanes) {
+                __m512i n = _mm512_loadu_si512(input + i);
+                _mm512_storeu_si512(output + i, subtract_product(n, divider.constants()(n), divider.divisor()));
+            }
+            remainder_array_scalar(divider, input + i, output + i, size - i);
+        }
+
+        template <typename Integer, template <typename I, bool S> class DivisionPolicy>
+        inline
+        void remainder_array(const constant_divider<Integer, DivisionPolicy>& divider,
+                             const Integer* input, Integer* output, std::size_t size, std::false_type)
+        {
+            record_divisions(divider.divisor(), simd_level::scalar, size);
+            remainder_array_scalar(divider, input, output, size);
+        }
+
+        template <typename Integer, template <typename I, bool S> class DivisionPolicy>
+        inline
+        void remainder_array(const constant_divider<Integer, DivisionPolicy>& divider,
+                             const Integer* input, Integer* output, std::size_t size, std::true_type)
+        {
+            const simd_level level = active_simd_level();
+            record_divisions(divider.divisor(), level, size);
+            switch (level) {
+            case simd_level::avx512:
+                remainder_array_avx512(divider, input, output, size);
+                break;
+            case simd_level::avx2:
+                remainder_array_avx2(divider, input, output, size);
+                break;
+            case simd_level::sse41:
+                remainder_array_sse41(divider, input, output, size);
+                break;
+            default:
+                remainder_array_scalar(divider, input, output, size);
+            }
+        }
+
+    }
+
+    /// Maps hashes to a prime number of buckets with hash % buckets computed by the remainder
+    /// path of a precomputed divider instead of a hardware division. The dividers of all
+    /// supported bucket counts are built at compile time, so the current one is selected by a
+    /// single atomic index: rehash swaps it in one store, and readers on other threads see either
+    /// the old or the new bucket count, never a mix of the two.
+    template <typename Integer = uint32_t, template <typename I, bool S> class DivisionPolicy = promotion_policy>
+    class prime_buckets {
+        static_assert(std::is_unsigned<Integer>::value && sizeof(Integer) >= sizeof(uint32_t),
+                      "Hashes are unsigned and wide enough for every bucket count");
+
+    public:
+        using value_type = Integer;
+        using divider_type = constant_divider<Integer, DivisionPolicy>;
+
+        /// The smallest supported bucket count of at least min_buckets.
+        explicit prime_buckets(std::size_t min_buckets = 0)
+            : level_(level_for(min_buckets))
+        {}
+
+        prime_buckets(const prime_buckets& other)
+            : level_(other.level_.load(std::memory_order_acquire))
+        {}
+
+        prime_buckets& operator=(const prime_buckets& other)
+        {
+            level_.store(other.level_.load(std::memory_order_acquire), std::memory_order_release);
+            return *this;
+        }
+
+        std::size_t bucket_count() const { return std::size_t(divider().divisor()); }
+
+        static constexpr std::size_t max_bucket_count() { return detail::bucket_primes[detail::num_bucket_primes - 1]; }
+
+        const divider_type& divider() const { return dividers_[level_.load(std::memory_order_acquire)]; }
+
+        Integer index(Integer hash) const { return divider().remainder(hash); }
+
+        /// output[i] = hashes[i] % bucket_count() for a block of hashes, with the widest SIMD
+        /// kernel available for the hash type. The bucket count is read once for the block.
+        void indices(const Integer* hashes, Integer* output, std::size_t size) const
+        {
+            detail::remainder_array(divider(), hashes, output, size, has_simd_kernels<Integer, DivisionPolicy>{});
+        }
+
+        /// Switch to the smallest supported bucket count of at least min_buckets and return it.
+        std::size_t rehash(std::size_t min_buckets)
+        {
+            level_.store(level_for(min_buckets), std::memory_order_release);
+            return bucket_count();
+        }
+
+    private:
+        static unsigned level_for(std::size_t min_buckets)
+        {
+            assert(min_buckets <= max_bucket_count());
+            unsigned level = 0;
+            while (level + 1 != detail::num_bucket_primes && detail::bucket_primes[level] < min_buckets) {
+                ++level;
+            }
+            return level;
+        }
+
+        constexpr static const std::array<divider_type, detail::num_bucket_primes> dividers_ =
+            detail::make_bucket_dividers<Integer, DivisionPolicy>(std::make_index_sequence<detail::num_bucket_primes>{});
+
+        std::atomic<unsigned> level_;
+    };
+
+    template <typename Integer, template <typename I, bool S> class DivisionPolicy>
+    constexpr const std::array<typename prime_buckets<Integer, DivisionPolicy>::divider_type, detail::num_bucket_primes>
+        prime_buckets<Integer, DivisionPolicy>::dividers_;
+
+    /// The usual alternative with the same interface: a power of two number of buckets indexed
+    /// by the low bits of the hash. Cheaper per index, but keys that differ only in high bits,
+    /// such as multiples of a large power of two under an identity hash, share buckets.
+    template <typename Integer = uint32_t>
+    class power_of_two_buckets {
+    public:
+        using value_type = Integer;
+
+        explicit power_of_two_buckets(std::size_t min_buckets = 0)
+            : mask_(mask_for(min_buckets))
+        {}
+
+        power_of_two_buckets(const power_of_two_buckets& other)
+            : mask_(other.mask_.load(std::memory_order_acquire))
+        {}
+
+        power_of_two_buckets& operator=(const power_of_two_buckets& other)
+        {
+            mask_.store(other.mask_.load(std::memory_order_acquire), std::memory_order_release);
+            return *this;
+        }
+
+        std::size_t bucket_count() const { return std::size_t(mask_.load(std::memory_order_acquire)) + 1; }
+
+        /// A mask of all ones indexes 2^N buckets, which for 64-bit words does not fit in std::size_t.
+        static constexpr std::size_t max_bucket_count()
+        {
+            return sizeof(Integer) < sizeof(std::size_t) ? std::size_t(1) << (8 * sizeof(Integer))
+                                                         : std::size_t(1) << (8 * sizeof(std::size_t) - 1);
+        }
+
+        Integer index(Integer hash) const { return Integer(hash & mask_.load(std::memory_order_acquire)); }
+
+        void indices(const Integer* hashes, Integer* output, std::size_t size) const
+        {
+            Integer mask = mask_.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i != size; ++i) {
+                output[i] = Integer(hashes[i] & mask);
+            }
+        }
+
+        std::size_t rehash(std::size_t min_buckets)
+        {
+            mask_.store(mask_for(min_buckets), std::memory_order_release);
+            return bucket_count();
+        }
+
+    private:
+        static Integer mask_for(std::size_t min_buckets)
+        {
+            assert(min_buckets <= max_bucket_count());
+            return min_buckets <= 2 ? Integer(1) : Integer((Integer(2) << utility::log2i(Integer(min_buckets - 1))) - 1);
+        }
+
+        std::atomic<Integer> mask_;
+    };
+
+    /// A reference open addressing hash map with linear probing on top of a bucket indexer.
+    /// std::size_t hashes are folded to the word of the indexer. Erasing shifts the following
+    /// entries of the probe sequence back, so there are no tombstones. The map itself is not
+    /// safe for concurrent modification.
+    template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Buckets = prime_buckets<>>
+    class flat_hash_map {
+    public:
+        using key_type = Key;
+        using mapped_type = Value;
+        using hash_type = typename Buckets::value_type;
+
+        /// Entries per bucket above which the table grows.
+        constexpr static const double max_load_factor = 0.75;
+        /// Keys hashed and indexed together by the batched find.
+        constexpr static const std::size_t batch_size = 64;
+
+        explicit flat_hash_map(std::size_t capacity = 0, Hash hash = Hash())
+            : hash_(std::move(hash)), buckets_(minimum_buckets(capacity))
+        {
+            slots_.resize(buckets_.bucket_count());
+        }
+
+        std::size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        std::size_t bucket_count() const { return buckets_.bucket_count(); }
+        const Buckets& buckets() const { return buckets_; }
+
+        /// Insert key with value unless it is present. Returns the mapped value and whether it
+        /// was inserted.
+        std::pair<Value*, bool> insert(const Key& key, Value value)
+        {
+            if (Value* found = find(key)) {
+                return { found, false };
+            }
+            if (size_ + 1 > std::size_t(max_load_factor * double(bucket_count()))) {
+                rehash(2 * bucket_count());
+            }
+            slot& target = slots_[free_slot(key)];
+            target.key = key;
+            target.value = std::move(value);
+            target.occupied = true;
+            ++size_;
+            return { &target.value, true };
+        }
+
+        Value& operator[](const Key& key)
+        {
+            return *insert(key, Value()).first;
+        }
+
+        Value* find(const Key& key)
+        {
+            return find_from(key, buckets_.index(hash_of(key)));
+        }
+
+        const Value* find(const Key& key) const
+        {
+            return const_cast<flat_hash_map*>(this)->find(key);
+        }
+
+        /// results[i] = find(keys[i]). The keys are hashed and their buckets computed in blocks,
+        /// so that the remainders run through the SIMD kernels of the indexer.
+        void find(const Key* keys, std::size_t size, Value** results)
+        {
+            hash_type hashes[batch_size];
+            hash_type indices[batch_size];
+            for (std::size_t first = 0; first < size; first += batch_size) {
+                std::size_t count = std::min(batch_size, size - first);
+                for (std::size_t i = 0; i != count; ++i) {
+                    hashes[i] = hash_of(keys[first + i]);
+                }
+                buckets_.indices(hashes, indices, count);
+                for (std::size_t i = 0; i != count; ++i) {
+                    results[first + i] = find_from(keys[first + i], indices[i]);
+                }
+            }
+        }
+
+        bool erase(const Key& key)
+        {
+            std::size_t buckets = bucket_count();
+            std::size_t i = buckets_.index(hash_of(key));
+            while (slots_[i].occupied && !(slots_[i].key == key)) {
+                i = next(i, buckets);
+            }
+            if (!slots_[i].occupied) {
+                return false;
+            }
+            // Move back every following entry whose home bucket is not between the hole and it.
+            std::size_t hole = i;
+            for (std::size_t j = next(hole, buckets); slots_[j].occupied; j = next(j, buckets)) {
+                std::size_t home = buckets_.index(hash_of(slots_[j].key));
+                bool stays = hole <= j ? (hole < home && home <= j) : (hole < home || home <= j);
+                if (!stays) {
+                    slots_[hole] = std::move(slots_[j]);
+                    hole = j;
+                }
+            }
+            slots_[hole] = slot();
+            --size_;
+            return true;
+        }
+
+        void clear()
+        {
+            for (auto& s : slots_) {
+                s = slot();
+            }
+            size_ = 0;
+        }
+
+        /// Grow to at least min_buckets buckets, which is rounded up by the indexer.
+        void rehash(std::size_t min_buckets)
+        {
+            std::vector<slot> old;
+            old.swap(slots_);
+            slots_.resize(buckets_.rehash(std::max(min_buckets, minimum_buckets(size_))));
+            for (auto& s : old) {
+                if (s.occupied) {
+                    slot& target = slots_[free_slot(s.key)];
+                    target = std::move(s);
+                }
+            }
+        }
+
+        void reserve(std::size_t capacity)
+        {
+            if (minimum_buckets(capacity) > bucket_count()) {
+                rehash(minimum_buckets(capacity));
+            }
+        }
+
+        /// Call f(key, value) for every entry.
+        template <typename F>
+        void for_each(F&& f) const
+        {
+            for (auto& s : slots_) {
+                if (s.occupied) {
+                    f(s.key, s.value);
+                }
+            }
+        }
+
+    private:
+        struct slot {
+            Key key{};
+            Value value{};
+            bool occupied = false;
+        };
+
+        static std::size_t minimum_buckets(std::size_t capacity)
+        {
+            return std::size_t(double(capacity) / max_load_factor) + 1;
+        }
+
+        static std::size_t next(std::size_t i, std::size_t buckets)
+        {
+            return i + 1 == buckets ? 0 : i + 1;
+        }
+
+        hash_type hash_of(const Key& key) const
+        {
+            uint64_t h = uint64_t(hash_(key));
+            return sizeof(hash_type) < sizeof(uint64_t) ? hash_type(h ^ (h >> 32)) : hash_type(h);
+        }
+
+        Value* find_from(const Key& key, std::size_t i)
+        {
+            std::size_t buckets = bucket_count();
+            while (slots_[i].occupied) {
+                if (slots_[i].key == key) {
+                    return &slots_[i].value;
+                }
+                i = next(i, buckets);
+            }
+            return nullptr;
+        }
+
+        std::size_t free_slot(const Key& key) const
+        {
+            std::size_t buckets = bucket_count();
+            std::size_t i = buckets_.index(hash_of(key));
+            while (slots_[i].occupied) {
+                i = next(i, buckets);
+            }
+            return i;
+        }
+
+        Hash hash_;
+        Buckets buckets_;
+        std::vector<slot> slots_;
+        std::size_t size_ = 0;
+    };
+
+}
@@ -0,0 +1,411 @@
+/**
+ *  Fast Division Library
+ *  Created by Stefan Ivanov
+ */
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include <immintrin.h>
+
+#include <fast_division/fast_division.hpp>
+#include <fast_division/fast_division_base.hpp>
+#include <fast_division/fast_division_dispatch.hpp>
+#include <fast_division/fast_division_simd.hpp>
+#include <fast_division/static_divider.hpp>
+#include <fast_division/utility/log2i.hpp>
+
+namespace fast_division {
+
+    /// The longest decimal representation of an Integer, sign included.
+    template <typename Integer>
+    constexpr std::size_t max_decimal_size()
+    {
+        return std::size_t(std::numeric_limits<Integer>::digits10 + 1 + std::is_signed<Integer>::value);
+    }
+
+    namespace detail {
+
+        /// "00" to "99", so that every division by 100 yields two characters at once.
+        constexpr char digit_pairs[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+
+        constexpr uint64_t powers_of_10[] = {
+            1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+            1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+            100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+            1000000000000000000ull, 10000000000000000000ull
+        };
+
+        /// The number of decimal digits of value, at least 1. log10(2) is close to 1233 / 4096,
+        /// which gives the count up to one, and a comparison with a power of 10 settles it.
+        /// value | 1 has the same count as value and keeps the logarithm defined for 0.
+        template <typename Unsigned>
+        inline constexpr
+        unsigned decimal_digits(Unsigned value)
+        {
+            Unsigned odd = Unsigned(value | Unsigned(1));
+            unsigned t = unsigned((utility::log2i(odd) + 1) * 1233) >> 12;
+            return t + unsigned(odd >= powers_of_10[t]);
+        }
+
+        /// Write value < 100 so that it ends at end.
+        inline
+        void write_2_digits_backwards(char* end, uint32_t value)
+        {
+            if (value >= 10) {
+                std::memcpy(end - 2, digit_pairs + 2 * value, 2);
+            }
+            else {
+                end[-1] = char('0' + value);
+            }
+        }
+
+        /// Write value < 10^4 so that it ends at end.
+        inline
+        void write_4_digits_backwards(char* end, uint32_t value)
+        {
+            constexpr static_divider<uint32_t, 100> by_100{};
+            if (value >= 100) {
+                uint32_t q = by_100(value);
+                std::memcpy(end - 2, digit_pairs + 2 * (value - 100 * q), 2);
+                end -= 2;
+                value = q;
+            }
+            write_2_digits_backwards(end, value);
+        }
+
+        /// Write exactly 4 digits of value < 10^4, with leading zeros.
+        inline
+        void write_4_digits(char* output, uint32_t value)
+        {
+            constexpr static_divider<uint32_t, 100> by_100{};
+            uint32_t q = by_100(value);
+            std::memcpy(output, digit_pairs + 2 * q, 2);
+            std::memcpy(output + 2, digit_pairs + 2 * (value - 100 * q), 2);
+        }
+
+        /// Write exactly 8 digits of value < 10^8, with leading zeros. The halves are independent,
+        /// so their divisions by 100 overlap.
+        inline
+        void write_8_digits(char* output, uint32_t value)
+        {
+            constexpr static_divider<uint32_t, 10000> by_10000{};
+            uint32_t high = by_10000(value);
+            write_4_digits(output, high);
+            write_4_digits(output + 4, value - 10000 * high);
+        }
+
+        /// Write the digits of value so that they end at end. Rather than a chain of divisions
+        /// by 100, where each waits for the previous quotient, the value is split by 10^8 or 10^4
+        /// first, which leaves at most three divisions in a row.
+        inline
+        void write_decimal_backwards(char* end, uint32_t value)
+        {
+            constexpr static_divider<uint32_t, 100000000> by_10_8{};
+            constexpr static_divider<uint32_t, 10000> by_10_4{};
+            if (value >= 100000000) {
+                uint32_t high = by_10_8(value);
+                write_8_digits(end - 8, value - 100000000 * high);
+                write_2_digits_backwards(end - 8, high);
+            }
+            else if (value >= 10000) {
+                uint32_t high = by_10_4(value);
+                write_4_digits(end - 4, value - 10000 * high);
+                write_4_digits_backwards(end - 4, high);
+            }
+            else {
+                write_4_digits_backwards(end, value);
+            }
+        }
+
+        /// 8 and 16-bit values have at most 5 digits, so one split by 10^4 is all they need.
+        inline
+        char* format_uint16(char* output, uint16_t value)
+        {
+            constexpr static_divider<uint32_t, 10000> by_10_4{};
+            char* end = output + decimal_digits(value);
+            if (value >= 10000) {
+                uint32_t high = by_10_4(value);
+                write_4_digits(end - 4, value - 10000 * high);
+                end[-5] = char('0' + high);
+            }
+            else {
+                write_4_digits_backwards(end, value);
+            }
+            return end;
+        }
+
+        inline
+        char* format_uint32(char* output, uint32_t value)
+        {
+            char* end = output + decimal_digits(value);
+            write_decimal_backwards(end, value);
+            return end;
+        }
+
+        /// Peel off 8 digits at a time by 64-bit division by 10^8 only until the rest fits 32 bits,
+        /// which the cheaper 32-bit dividers take from there.
+        inline
+        char* format_uint64(char* output, uint64_t value)
+        {
+            constexpr static_divider<uint64_t, 100000000> by_10_8{};
+            constexpr uint32_t max_32 = std::numeric_limits<uint32_t>::max();
+            char* end = output + decimal_digits(value);
+            char* low_end = end;
+            while (value > max_32) {
+                uint64_t high = by_10_8(value);
+                write_8_digits(low_end - 8, uint32_t(value - 100000000 * high));
+                low_end -= 8;
+                value = high;
+            }
+            write_decimal_backwards(low_end, uint32_t(value));
+            return end;
+        }
+
+        /// Every width takes its own path, so that narrow values are never written with the
+        /// assumption of room for the digits of wider ones.
+        template <int Bits>
+        using decimal_width = std::integral_constant<int, Bits>;
+
+        inline
+        char* format_unsigned(char* output, uint16_t value, decimal_width<16>)
+        {
+            return format_uint16(output, value);
+        }
+
+        inline
+        char* format_unsigned(char* output, uint32_t value, decimal_width<32>)
+        {
+            return format_uint32(output, value);
+        }
+
+        inline
+        char* format_unsigned(char* output, uint64_t value, decimal_width<64>)
+        {
+            return format_uint64(output, value);
+        }
+
+        template <typename Unsigned>
+        inline
+        char* format_unsigned(char* output, Unsigned value)
+        {
+            using width = decimal_width<sizeof(Unsigned) <= 2 ? 16 : sizeof(Unsigned) <= 4 ? 32 : 64>;
+            return format_unsigned(output, value, width());
+        }
+
+        /// The digits of up to 8 values at a time. A value below 2^32 splits into a top part below
+        /// 43 and two 4-digit parts by divisions by 10^8 and 10^4. Every 4-digit part x becomes
+        /// x / 100 and x % 100 in the two 16-bit halves of its lane, and one 16-bit division by 10
+        /// of these leaves tens and ones, which interleave into four characters in reading order.
+        /// The digits are thus computed 8 (and for the last step 16) lanes at a time; only copying
+        /// the significant characters of every value is scalar.
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i four_characters_avx2(__m256i value)
+        {
+            constexpr constant_divider_base<uint32_t, false, promotion_policy> by_100(100);
+            constexpr constant_divider_base<uint16_t, false, promotion_policy> by_10(10);
+            __m256i high = by_100(value);
+            __m256i low = _mm256_sub_epi32(value, _mm256_mullo_epi32(high, _mm256_set1_epi32(100)));
+            __m256i pairs = _mm256_or_si256(high, _mm256_slli_epi32(low, 16));
+            __m256i tens = by_10(pairs);
+            __m256i ones = _mm256_sub_epi16(pairs, _mm256_mullo_epi16(tens, _mm256_set1_epi16(10)));
+            __m256i digits = _mm256_or_si256(tens, _mm256_slli_epi16(ones, 8));
+            return _mm256_add_epi8(digits, _mm256_set1_epi8('0'));
+        }
+
+        /// The number of decimal digits of every lane, from comparisons with 10^k - 1. AVX2 only
+        /// compares signed integers, so both sides are offset by 2^31.
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i decimal_digits_avx2(__m256i value)
+        {
+            const __m256i sign = _mm256_set1_epi32(int(0x80000000u));
+            __m256i biased = _mm256_xor_si256(value, sign);
+            __m256i digits = _mm256_set1_epi32(1);
+            for (std::size_t k = 1; k != 10; ++k) {
+                __m256i limit = _mm256_xor_si256(_mm256_set1_epi32(int(uint32_t(powers_of_10[k] - 1))), sign);
+                digits = _mm256_sub_epi32(digits, _mm256_cmpgt_epi32(biased, limit));
+            }
+            return digits;
+        }
+
+        /// The 12 characters of lanes k and k + 4 of four_characters of top, middle and bottom are
+        /// brought together in the two halves of a vector by unpacking, then shifted by a byte
+        /// shuffle so that the significant digits come first. Every text is stored as 16 bytes,
+        /// which overwrite the following bytes of the output but are at most 11 long themselves.
+        /// The last value is formatted by the scalar tail, so the 16 bytes are always within the
+        /// room required for the values left.
+        inline FAST_DIVISION_TARGET_AVX2
+        char* format_decimal_avx2(const uint32_t* values, std::size_t size, char* output, char separator)
+        {
+            constexpr constant_divider_base<uint32_t, false, promotion_policy> by_10_8(100000000);
+            constexpr constant_divider_base<uint32_t, false, promotion_policy> by_10_4(10000);
+            const __m256i positions = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                                                       0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+            std::size_t i = 0;
+            for (; i + 8 < size; i += 8) {
+                __m256i n = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+                __m256i top = by_10_8(n);
+                __m256i rest = _mm256_sub_epi32(n, _mm256_mullo_epi32(top, _mm256_set1_epi32(100000000)));
+                __m256i middle = by_10_4(rest);
+                __m256i bottom = _mm256_sub_epi32(rest, _mm256_mullo_epi32(middle, _mm256_set1_epi32(10000)));
+                __m256i high = four_characters_avx2(top);
+                __m256i low = four_characters_avx2(middle);
+                __m256i last = four_characters_avx2(bottom);
+                __m256i digits = decimal_digits_avx2(n);
+                // The shift of every lane, 12 - digits, in the lowest byte of the lane.
+                __m256i shifts = _mm256_sub_epi32(_mm256_set1_epi32(12), digits);
+
+                __m256i pairs[2] = { _mm256_unpacklo_epi32(high, low), _mm256_unpackhi_epi32(high, low) };
+                __m256i lasts[2] = { _mm256_unpacklo_epi32(last, _mm256_setzero_si256()),
+                                     _mm256_unpackhi_epi32(last, _mm256_setzero_si256()) };
+                alignas(32) char texts[8][16];
+                for (int k = 0; k != 4; ++k) {
+                    __m256i text = (k & 1) ? _mm256_unpackhi_epi64(pairs[k / 2], lasts[k / 2])
+                                           : _mm256_unpacklo_epi64(pairs[k / 2], lasts[k / 2]);
+                    __m256i shift = _mm256_shuffle_epi8(shifts, _mm256_set1_epi8(char(4 * k)));
+                    text = _mm256_shuffle_epi8(text, _mm256_add_epi8(positions, shift));
+                    _mm_store_si128(reinterpret_cast<__m128i*>(texts[k]), _mm256_castsi256_si128(text));
+                    _mm_store_si128(reinterpret_cast<__m128i*>(texts[k + 4]), _mm256_extracti128_si256(text, 1));
+                }
+                alignas(32) uint32_t lengths[8];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(lengths), digits);
+                for (std::size_t lane = 0; lane != 8; ++lane) {
+                    std::memcpy(output, texts[lane], 16);
+                    output += lengths[lane];
+                    *output++ = separator;
+                }
+            }
+            for (; i != size; ++i) {
+                output = format_uint32(output, values[i]);
+                *output++ = separator;
+            }
+            return output;
+        }
+
+    }
+
+    /// Write the decimal representation of value to output and return the end of it, like
+    /// std::to_chars with enough room. output must have room for max_decimal_size<Integer>()
+    /// characters. No terminating null is written.
+    /// The sign of random values is unpredictable, so the '-' is always written and only kept
+    /// for negative values, and the magnitude is taken with a mask instead of a branch.
+    template <typename Integer, typename = std::enable_if_t<std::is_integral<Integer>::value>>
+    inline
+    char* format_decimal(char* output, Integer value)
+    {
+        using u_type = std::make_unsigned_t<Integer>;
+        const bool negative = value < Integer(0);
+        const u_type sign = u_type(u_type(0) - u_type(negative));
+        *output = '-';
+        output += negative;
+        return detail::format_unsigned(output, u_type(u_type(u_type(value) ^ sign) - sign));
+    }
+
+    /// Write every value followed by separator and return the end of the output, which must
+    /// have room for size * (max_decimal_size<uint32_t>() + 1) characters. On AVX2 processors the
+    /// digits of 8 values are computed at once.
+    inline
+    char* format_decimal(const uint32_t* values, std::size_t size, char* output, char separator = '\n')
+    {
+        if (active_simd_level() >= simd_level::avx2) {
+            return detail::format_decimal_avx2(values, size, output, separator);
+        }
+        for (std::size_t i = 0; i != size; ++i) {
+            output = detail::format_uint32(output, values[i]);
+            *output++ = separator;
+        }
+        return output;
+    }
+
+    /// Formats integers in a base chosen at runtime, from 2 to 36, with lowercase letters for
+    /// digits above 9. Two digits are produced per division by a divider of base^2, looked up
+    /// in a table built with the formatter. Power of two bases shift instead of dividing.
+    template <typename Integer>
+    class radix_formatter {
+    public:
+        using value_type = Integer;
+        using u_type = std::make_unsigned_t<Integer>;
+
+        /// Enough for every value in base 2.
+        constexpr static const std::size_t max_size = sizeof(Integer) * 8 + std::is_signed<Integer>::value;
+
+        explicit radix_formatter(unsigned base)
+            : base_(base),
+              bits_((base & (base - 1)) == 0 ? unsigned(utility::log2i(base)) : 0u),
+              by_base_(u_type(base)),
+              by_square_(square_fits() ? u_type(base * base) : u_type(1)),
+              pairs_(2 * base * base)
+        {
+            assert(base >= 2 && base <= 36);
+            for (unsigned i = 0; i != base * base; ++i) {
+                pairs_[2 * i] = digit(i / base);
+                pairs_[2 * i + 1] = digit(i % base);
+            }
+        }
+
+        unsigned base() const { return base_; }
+
+        /// Write value in the base to output, which needs room for max_size characters, and
+        /// return the end of it.
+        char* operator()(char* output, Integer value) const
+        {
+            u_type magnitude = u_type(value);
+            if (value < 0) {
+                *output++ = '-';
+                magnitude = u_type(u_type(0) - magnitude);
+            }
+            char buffer[max_size];
+            char* begin = buffer + max_size;
+            if (square_fits()) {
+                const u_type square = u_type(base_ * base_);
+                while (magnitude >= square) {
+                    u_type q = divide(magnitude, by_square_, 2 * bits_);
+                    begin -= 2;
+                    std::memcpy(begin, pairs_.data() + 2 * (magnitude - q * square), 2);
+                    magnitude = q;
+                }
+            }
+            do {
+                u_type q = divide(magnitude, by_base_, bits_);
+                *--begin = digit(unsigned(magnitude - q * u_type(base_)));
+                magnitude = q;
+            } while (magnitude != 0);
+            std::size_t size = std::size_t(buffer + max_size - begin);
+            std::memcpy(output, begin, size);
+            return output + size;
+        }
+
+    private:
+        /// The square of the base overflows 8-bit words from base 16 up.
+        bool square_fits() const
+        {
+            return std::size_t(base_) * base_ <= std::numeric_limits<u_type>::max();
+        }
+
+        u_type divide(u_type input, const constant_divider<u_type>& divider, unsigned bits) const
+        {
+            return bits_ != 0 ? u_type(input >> bits) : divider(input);
+        }
+
+        static char digit(unsigned value)
+        {
+            return char(value < 10 ? '0' + value : 'a' + (value - 10));
+        }
+
+        unsigned base_;
+        unsigned bits_;
+        constant_divider<u_type> by_base_;
+        constant_divider<u_type> by_square_;
+        std::vector<char> pairs_;
+    };
+
+}
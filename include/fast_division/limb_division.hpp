@@ -0,0 +1,121 @@
+/**
+ *  Fast Division Library
+ *  Created by Stefan Ivanov
+ *
+ *  Using ideas from
+ *  Improved Division by Invariant Integers (2011), section 8
+ *  by Niels Möller, Torbjörn Granlund
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <fast_division/double_word_divider.hpp>
+
+namespace fast_division {
+
+    namespace detail {
+
+        /// Limb i of the number shifted left by s, taking its low bits from limb i - 1.
+        /// Shifting right in two steps keeps s == 0 defined.
+        template <typename Limb>
+        inline Limb shifted_limb(const Limb* number, std::size_t i, unsigned s)
+        {
+            constexpr unsigned word_size = 8 * sizeof(Limb);
+            const Limb low = i != 0 ? Limb(Limb(number[i - 1] >> 1) >> (word_size - 1 - s)) : Limb(0);
+            return Limb(Limb(number[i] << s) | low);
+        }
+
+        /// The shifted remainder of the number with size limbs, starting from its top limb.
+        /// The bits shifted out of the top limb form the first, extra limb.
+        template <typename Limb>
+        inline Limb top_remainder(const Limb* number, std::size_t size, unsigned s)
+        {
+            constexpr unsigned word_size = 8 * sizeof(Limb);
+            return size != 0 ? Limb(Limb(number[size - 1] >> 1) >> (word_size - 1 - s)) : Limb(0);
+        }
+
+        /// Reduces the limbs [to, from) of the number into the shifted remainder r.
+        template <typename Limb>
+        inline Limb reduce_limbs(const Limb* number, std::size_t from, std::size_t to, Limb r,
+                                 const double_word_divider<Limb>& divider)
+        {
+            const unsigned s = divider.shift();
+            for (std::size_t i = from; i != to; --i) {
+                divider.divide_normalized(r, shifted_limb(number, i - 1, s), r);
+            }
+            return r;
+        }
+
+    }
+
+    /// Divides the multi-word number with size limbs, least significant first, by the divisor of
+    /// divider and returns the remainder. This is long division, one double-word division per
+    /// limb. The number and divisor are shifted on the fly so that the top bit of the divisor is
+    /// set, as the quotient does not change, and the running remainder is kept shifted. quotient
+    /// receives size limbs and may be numerator itself.
+    template <typename Limb>
+    inline
+    Limb divide_limbs(const Limb* numerator, std::size_t size, const double_word_divider<Limb>& divider,
+                      Limb* quotient)
+    {
+        static_assert(std::is_unsigned<Limb>::value, "Limbs must be unsigned");
+        const unsigned s = divider.shift();
+        Limb r = detail::top_remainder(numerator, size, s);
+        for (std::size_t i = size; i != 0; --i) {
+            // Limb i - 2 is read before quotient limb i - 1 is written, so they may alias.
+            quotient[i - 1] = divider.divide_normalized(r, detail::shifted_limb(numerator, i - 1, s), r);
+        }
+        return Limb(r >> s);
+    }
+
+    /// The remainder of the multi-word number modulo the divisor, without the quotient.
+    template <typename Limb>
+    inline
+    Limb remainder_limbs(const Limb* number, std::size_t size, const double_word_divider<Limb>& divider)
+    {
+        static_assert(std::is_unsigned<Limb>::value, "Limbs must be unsigned");
+        const unsigned s = divider.shift();
+        return Limb(detail::reduce_limbs(number, size, 0, detail::top_remainder(number, size, s), divider) >> s);
+    }
+
+    /// Remainders of count multi-word numbers modulo the same divisor. numbers[k] has sizes[k]
+    /// limbs. Every division of long division waits on the previous remainder, so four numbers
+    /// are reduced in lockstep and their divisions overlap. Each of the four first reduces its
+    /// limbs above the shortest of them on its own.
+    template <typename Limb>
+    inline
+    void remainder_limbs(const Limb* const* numbers, const std::size_t* sizes, std::size_t count,
+                         const double_word_divider<Limb>& divider, Limb* remainders)
+    {
+        static_assert(std::is_unsigned<Limb>::value, "Limbs must be unsigned");
+        constexpr std::size_t lanes = 4;
+        const unsigned s = divider.shift();
+        const std::size_t batched = count - count % lanes;
+        std::size_t k = 0;
+        for (; k != batched; k += lanes) {
+            const std::size_t common = *std::min_element(sizes + k, sizes + k + lanes);
+            Limb r[lanes];
+            for (std::size_t j = 0; j != lanes; ++j) {
+                const Limb* number = numbers[k + j];
+                r[j] = detail::reduce_limbs(number, sizes[k + j], common,
+                                            detail::top_remainder(number, sizes[k + j], s), divider);
+            }
+            for (std::size_t i = common; i != 0; --i) {
+                for (std::size_t j = 0; j != lanes; ++j) {
+                    divider.divide_normalized(r[j], detail::shifted_limb(numbers[k + j], i - 1, s), r[j]);
+                }
+            }
+            for (std::size_t j = 0; j != lanes; ++j) {
+                remainders[k + j] = Limb(r[j] >> s);
+            }
+        }
+        for (; k < count; ++k) {
+            remainders[k] = remainder_limbs(numbers[k], sizes[k], divider);
+        }
+    }
+
+}
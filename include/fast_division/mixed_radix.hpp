@@ -0,0 +1,241 @@
+/**
+ *  Fast Division Library
+ *  Created by Stefan Ivanov
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <immintrin.h>
+
+#include <fast_division/fast_division.hpp>
+#include <fast_division/fast_division_dispatch.hpp>
+#include <fast_division/fast_division_simd.hpp>
+
+namespace fast_division {
+
+    namespace detail {
+
+        template <typename Integer, template <typename I, bool S> class DivisionPolicy, std::size_t... Indices>
+        constexpr std::array<constant_divider<Integer, DivisionPolicy>, sizeof...(Indices)>
+        make_radix_dividers(const std::array<Integer, sizeof...(Indices)>& radices, std::index_sequence<Indices...>)
+        {
+            return { { constant_divider<Integer, DivisionPolicy>(radices[Indices])... } };
+        }
+
+        /// Every index takes one division per radix, counted like bulk division under the level
+        /// decompose dispatched to.
+        template <typename Integer, template <typename I, bool S> class DivisionPolicy, std::size_t Radices>
+        inline
+        void record_radix_divisions(const std::array<constant_divider<Integer, DivisionPolicy>, Radices>& dividers,
+                                    simd_level level, std::size_t size)
+        {
+            if (statistics_enabled) {
+                for (auto& divider : dividers) {
+                    record_divisions(divider.divisor(), level, size);
+                }
+            }
+        }
+
+        /// Decomposition of whole arrays, with the same structure as the bulk division kernels.
+        /// Every step takes the quotient and the remainder from one reciprocal multiplication.
+        /// The kernels call those of the base, which carry the target of their width, and are
+        /// counted once per array by decompose_array.
+
+        template <typename Integer, template <typename I, bool S> class DivisionPolicy, std::size_t Radices>
+        inline
+        void decompose_array_scalar(const std::array<constant_divider<Integer, DivisionPolicy>, Radices>& dividers,
+                                    const Integer* indices, std::size_t size, Integer* const* digits)
+        {
+            for (std::size_t i = 0; i != size; ++i) {
+                Integer n = indices[i];
+                for (std::size_t k = 0; k != Radices; ++k) {
+                    Integer q = dividers[k].constants()(n);
+                    digits[k][i] = Integer(n - Integer(q * dividers[k].divisor()));
+                    n = q;
+                }
+                digits[Radices][i] = n;
+            }
+        }
+
+        template <typename Integer, template <typename I, bool S> class DivisionPolicy, std::size_t Radices>
+        inline FAST_DIVISION_TARGET_SSE41
+        void decompose_array_sse41(const std::array<constant_divider<Integer, DivisionPolicy>, Radices>& dividers,
+                                   const Integer* indices, std::size_t size, Integer* const* digits)
+        {
+            constexpr std::size_t lanes = sizeof(__m128i) / sizeof(Integer);
+            std::size_t i = 0;
+            for (; i + lanes <= size; i += lanes) {
+                __m128i n = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i));
+                for (std::size_t k = 0; k != Radices; ++k) {
+                    __m128i q = dividers[k].constants()(n);
+                    __m128i r = subtract_product(n, q, dividers[k].divisor());
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(digits[k] + i), r);
+                    n = q;
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(digits[Radices] + i), n);
+            }
+            std::array<Integer*, Radices + 1> tail;
+            for (std::size_t k = 0; k != Radices + 1; ++k) {
+                tail[k] = digits[k] + i;
+            }
+            decompose_array_scalar(dividers, indices + i, size - i, tail.data());
+        }
+
+        template <typename Integer, template <typename I, bool S> class DivisionPolicy, std::size_t Radices>
+        inline FAST_DIVISION_TARGET_AVX2
+        void decompose_array_avx2(const std::array<constant_divider<Integer, DivisionPolicy>, Radices>& dividers,
+                                  const Integer* indices, std::size_t size, Integer* const* digits)
+        {
+            constexpr std::size_t lanes = sizeof(__m256i) / sizeof(Integer);
+            std::size_t i = 0;
+            for (; i + lanes <= size; i += lanes) {
+                __m256i n = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+                for (std::size_t k = 0; k != Radices; ++k) {
+                    __m256i q = dividers[k].constants()(n);
+                    __m256i r = subtract_product(n, q, dividers[k].divisor());
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(digits[k] + i), r);
+                    n = q;
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(digits[Radices] + i), n);
+            }
+            std::array<Integer*, Radices + 1> tail;
+            for (std::size_t k = 0; k != Radices + 1; ++k) {
+                tail[k] = digits[k] + i;
+            }
+            decompose_array_scalar(dividers, indices + i, size - i, tail.data());
+        }
+
+        template <typename Integer, template <typename I, bool S> class DivisionPolicy, std::size_t Radices>
+        inline FAST_DIVISION_TARGET_AVX512
+        void decompose_array_avx512(const std::array<constant_divider<Integer, DivisionPolicy>, Radices>& dividers,
+                                    const Integer* indices, std::size_t size, Integer* const* digits)
+        {
+            constexpr std::size_t lanes = sizeof(__m512i) / sizeof(Integer);
+            std::size_t i = 0;
+            for (; i + lanes <= size; i += lanes) {
+                __m512i n = _mm512_loadu_si512(indices + i);
+                for (std::size_t k = 0; k != Radices; ++k) {
+                    __m512i q = dividers[k].constants()(n);
+                    __m512i r = subtract_product(n, q, dividers[k].divisor());
+                    _mm512_storeu_si512(digits[k] + i, r);
+                    n = q;
+                }
+                _mm512_storeu_si512(digits[Radices] + i, n);
+            }
+            std::array<Integer*, Radices + 1> tail;
+            for (std::size_t k = 0; k != Radices + 1; ++k) {
+                tail[k] = digits[k] + i;
+            }
+            decompose_array_scalar(dividers, indices + i, size - i, tail.data());
+        }
+
+        template <typename Integer, template <typename I, bool S> class DivisionPolicy, std::size_t Radices>
+        inline
+        void decompose_array(const std::array<constant_divider<Integer, DivisionPolicy>, Radices>& dividers,
+                             const Integer* indices, std::size_t size, Integer* const* digits, std::false_type)
+        {
+            record_radix_divisions(dividers, simd_level::scalar, size);
+            decompose_array_scalar(dividers, indices, size, digits);
+        }
+
+        template <typename Integer, template <typename I, bool S> class DivisionPolicy, std::size_t Radices>
+        inline
+        void decompose_array(const std::array<constant_divider<Integer, DivisionPolicy>, Radices>& dividers,
+                             const Integer* indices, std::size_t size, Integer* const* digits, std::true_type)
+        {
+            const simd_level level = active_simd_level();
+            record_radix_divisions(dividers, level, size);
+            switch (level) {
+            case simd_level::avx512:
+                decompose_array_avx512(dividers, indices, size, digits);
+                break;
+            case simd_level::avx2:
+                decompose_array_avx2(dividers, indices, size, digits);
+                break;
+            case simd_level::sse41:
+                decompose_array_sse41(dividers, indices, size, digits);
+                break;
+            default:
+                decompose_array_scalar(dividers, indices, size, digits);
+            }
+        }
+
+    }
+
+    /// A mixed-radix number system with runtime radices, for turning flat indices into
+    /// coordinates, e.g. radices (width, height) for (x, y, z) in a 3D grid, or (60, 60, 24)
+    /// for the seconds, minutes, hours and days of a duration. Digit k is the remainder of the
+    /// division by radix k of the quotient left by the previous digits, least significant
+    /// first; the last of the Radices + 1 digits is the final quotient and is not bounded.
+    /// Each step takes both from a precomputed divider, see constant_divider::divmod.
+    template <typename Integer, std::size_t Radices,
+              template <typename I, bool S> class DivisionPolicy = promotion_policy>
+    class mixed_radix {
+    public:
+        constexpr static const std::size_t num_digits = Radices + 1;
+        using value_type = Integer;
+        using digits_type = std::array<Integer, num_digits>;
+
+        constexpr explicit mixed_radix(const std::array<Integer, Radices>& radices)
+            : dividers_(detail::make_radix_dividers<Integer, DivisionPolicy>(radices, std::make_index_sequence<Radices>()))
+        {}
+
+        constexpr const Integer& radix(std::size_t k) const { return dividers_[k].divisor(); }
+
+        constexpr const constant_divider<Integer, DivisionPolicy>& divider(std::size_t k) const { return dividers_[k]; }
+
+        constexpr digits_type decompose(Integer index) const
+        {
+            digits_type digits{};
+            for (std::size_t k = 0; k != Radices; ++k) {
+                auto qr = dividers_[k].divmod(index);
+                digits[k] = qr.remainder;
+                index = qr.quotient;
+            }
+            digits[Radices] = index;
+            return digits;
+        }
+
+        /// The inverse of decompose, by Horner's rule from the most significant digit.
+        constexpr Integer compose(const digits_type& digits) const
+        {
+            Integer index = digits[Radices];
+            for (std::size_t k = Radices; k != 0; --k) {
+                index = Integer(index * radix(k - 1) + digits[k - 1]);
+            }
+            return index;
+        }
+
+        /// Decompose size indices into num_digits arrays of size digits each, digits[k][i]
+        /// being digit k of indices[i], with the widest SIMD kernel available at runtime where
+        /// the divider has one. Every lane of a vector is a different index.
+        void decompose(const Integer* indices, std::size_t size, Integer* const* digits) const
+        {
+            detail::decompose_array(dividers_, indices, size, digits, has_simd_kernels<Integer, DivisionPolicy>());
+        }
+
+        /// The inverse of the array decompose. The loops over indices have no dependencies
+        /// between iterations and are left to the compiler to vectorize.
+        void compose(const Integer* const* digits, std::size_t size, Integer* indices) const
+        {
+            for (std::size_t i = 0; i != size; ++i) {
+                indices[i] = digits[Radices][i];
+            }
+            for (std::size_t k = Radices; k != 0; --k) {
+                const Integer r = radix(k - 1);
+                const Integer* digit = digits[k - 1];
+                for (std::size_t i = 0; i != size; ++i) {
+                    indices[i] = Integer(indices[i] * r + digit[i]);
+                }
+            }
+        }
+
+    private:
+        std::array<constant_divider<Integer, DivisionPolicy>, Radices> dividers_;
+    };
+
+}
@@ -0,0 +1,373 @@
+/**
+ *  Fast Division Library
+ *  Created by Stefan Ivanov
+ *
+ *  Using ideas from
+ *  Modular Multiplication Without Trial Division (1985)
+ *  by Peter L. Montgomery
+ *  Improved Division by Invariant Integers (2011)
+ *  by Niels Möller, Torbjörn Granlund
+ */
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <immintrin.h>
+
+#include <fast_division/double_word_divider.hpp>
+#include <fast_division/division_policy.hpp>
+#include <fast_division/fast_division.hpp>
+#include <fast_division/fast_division_dispatch.hpp>
+#include <fast_division/utility/cpu_features.hpp>
+#include <fast_division/utility/high_multiplication.hpp>
+#include <fast_division/utility/modular_inverse.hpp>
+#include <fast_division/utility/wide_division.hpp>
+
+namespace fast_division {
+
+    namespace detail {
+
+        /// a + b modulo m for a, b < m, without overflowing the word.
+        template <typename UInteger>
+        inline constexpr
+        UInteger add_mod(UInteger a, UInteger b, UInteger m)
+        {
+            const UInteger complement = UInteger(m - b);
+            return a >= complement ? UInteger(a - complement) : UInteger(a + b);
+        }
+
+        /// a - b modulo m for a, b < m.
+        template <typename UInteger>
+        inline constexpr
+        UInteger subtract_mod(UInteger a, UInteger b, UInteger m)
+        {
+            return UInteger(UInteger(a - b) + (a < b ? m : UInteger(0)));
+        }
+
+        /// Lanes of all ones where the unsigned 32-bit lane of x is below that of y.
+        inline FAST_DIVISION_TARGET_SSE41
+        __m128i less_epu32(__m128i x, __m128i y)
+        {
+            const __m128i sign = _mm_set1_epi32(int32_t(0x80000000u));
+            return _mm_cmpgt_epi32(_mm_xor_si128(y, sign), _mm_xor_si128(x, sign));
+        }
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i less_epu32(__m256i x, __m256i y)
+        {
+            const __m256i sign = _mm256_set1_epi32(int32_t(0x80000000u));
+            return _mm256_cmpgt_epi32(_mm256_xor_si256(y, sign), _mm256_xor_si256(x, sign));
+        }
+
+        /// Montgomery products of 32-bit lanes. The high halves of the even and odd products are
+        /// blended back into 32-bit lanes, and t * m is subtracted from them as in the scalar code.
+
+        inline FAST_DIVISION_TARGET_SSE41
+        __m128i montgomery_multiply(__m128i x, __m128i y, __m128i modulus, __m128i inverse)
+        {
+            const __m128i even = _mm_mul_epu32(x, y);
+            const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(x, 32), _mm_srli_epi64(y, 32));
+            const __m128i low = _mm_blend_epi16(even, _mm_slli_epi64(odd, 32), 0xCC);
+            const __m128i high = _mm_blend_epi16(_mm_srli_epi64(even, 32), odd, 0xCC);
+            const __m128i t = _mm_mullo_epi32(low, inverse);
+            const __m128i t_even = _mm_mul_epu32(t, modulus);
+            const __m128i t_odd = _mm_mul_epu32(_mm_srli_epi64(t, 32), modulus);
+            const __m128i h = _mm_blend_epi16(_mm_srli_epi64(t_even, 32), t_odd, 0xCC);
+            const __m128i r = _mm_sub_epi32(high, h);
+            return _mm_add_epi32(r, _mm_and_si128(less_epu32(high, h), modulus));
+        }
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i montgomery_multiply(__m256i x, __m256i y, __m256i modulus, __m256i inverse)
+        {
+            const __m256i even = _mm256_mul_epu32(x, y);
+            const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(y, 32));
+            const __m256i low = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+            const __m256i high = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+            const __m256i t = _mm256_mullo_epi32(low, inverse);
+            const __m256i t_even = _mm256_mul_epu32(t, modulus);
+            const __m256i t_odd = _mm256_mul_epu32(_mm256_srli_epi64(t, 32), modulus);
+            const __m256i h = _mm256_blend_epi32(_mm256_srli_epi64(t_even, 32), t_odd, 0xAA);
+            const __m256i r = _mm256_sub_epi32(high, h);
+            return _mm256_add_epi32(r, _mm256_and_si256(less_epu32(high, h), modulus));
+        }
+
+        /// Barrett products of 32-bit operands held in 64-bit lanes, which fit the whole product.
+        /// It is shifted by the normalization shift and divided as in double_word_divider, with
+        /// the 32-bit wrap arounds done by masking. SSE4.1 has two such lanes and no 64-bit
+        /// comparison, which loses to the scalar code, so there is only an AVX2 kernel.
+
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i barrett_multiply(__m256i x, __m256i y, __m256i divisor, __m256i reciprocal, __m128i shift)
+        {
+            const __m256i low_mask = _mm256_set1_epi64x(0xFFFFFFFF);
+            const __m256i u = _mm256_sll_epi64(_mm256_mul_epu32(x, y), shift);
+            // (q_1, q_0) = v * u_1 + (u_1 + 1, u_0)
+            const __m256i q = _mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(reciprocal, _mm256_srli_epi64(u, 32)), u),
+                                               _mm256_set1_epi64x(int64_t(1) << 32));
+            const __m256i q_0 = _mm256_and_si256(q, low_mask);
+            __m256i r = _mm256_and_si256(_mm256_sub_epi64(u, _mm256_mul_epu32(_mm256_srli_epi64(q, 32), divisor)), low_mask);
+            r = _mm256_and_si256(_mm256_add_epi64(r, _mm256_and_si256(_mm256_cmpgt_epi64(r, q_0), divisor)), low_mask);
+            r = _mm256_sub_epi64(r, _mm256_andnot_si256(_mm256_cmpgt_epi64(divisor, r), divisor));
+            return _mm256_srl_epi64(r, shift);
+        }
+
+    }
+
+    /// Arithmetic modulo an invariant modulus m of any value from 1 up, by Barrett reduction:
+    /// the quotient of a product by m is estimated with a precomputed reciprocal and corrected.
+    /// Moduli narrower than 64 bits reduce the promoted product with a constant_divider of the
+    /// wider type. 64-bit products would overflow that, so they are kept as a double word and
+    /// reduced by the reciprocal of the normalized modulus as in double_word_divider, which
+    /// needs no wider type at all. Operands of addmod and submod, and the first operand of
+    /// mulmod for 64-bit moduli, must be reduced, i.e. below m.
+    template <typename UInteger>
+    class barrett_modulus {
+    public:
+        static_assert(std::is_unsigned<UInteger>::value, "Modular arithmetic requires an unsigned type");
+
+        using value_type = UInteger;
+        using is_narrow = std::integral_constant<bool, (sizeof(UInteger) < sizeof(uint64_t))>;
+        using product_type = std::conditional_t<is_narrow::value, utility::promotion_t<UInteger>, UInteger>;
+
+        constexpr explicit barrett_modulus(UInteger modulus)
+            : divider_(modulus), product_divider_(modulus)
+        {}
+
+        constexpr const UInteger& modulus() const { return divider_.divisor(); }
+
+        constexpr UInteger reduce(UInteger x) const
+        {
+            return UInteger(product_divider_.remainder(x));
+        }
+
+        constexpr UInteger addmod(UInteger a, UInteger b) const
+        {
+            return detail::add_mod(a, b, modulus());
+        }
+
+        constexpr UInteger submod(UInteger a, UInteger b) const
+        {
+            return detail::subtract_mod(a, b, modulus());
+        }
+
+        constexpr UInteger mulmod(UInteger a, UInteger b) const
+        {
+            return mulmod(a, b, is_narrow());
+        }
+
+        constexpr UInteger powmod(UInteger base, uint64_t exponent) const
+        {
+            UInteger result = reduce(UInteger(1));
+            base = reduce(base);
+            for (; exponent != 0; exponent >>= 1) {
+                if (exponent & 1) {
+                    result = mulmod(result, base);
+                }
+                base = mulmod(base, base);
+            }
+            return result;
+        }
+
+        /// output[i] = a[i] * b[i] modulo m, with AVX2 for 32-bit moduli. Every a[i] must be below m.
+        void mulmod(const UInteger* a, const UInteger* b, UInteger* output, std::size_t size) const
+        {
+            mulmod_array(a, b, output, size, std::is_same<UInteger, uint32_t>());
+        }
+
+    private:
+        constexpr UInteger mulmod(UInteger a, UInteger b, std::true_type) const
+        {
+            return UInteger(product_divider_.remainder(utility::low_mult(product_type(a), product_type(b))));
+        }
+
+        /// The high word of the product is below m as long as a is.
+        constexpr UInteger mulmod(UInteger a, UInteger b, std::false_type) const
+        {
+            return divider_.remainder(utility::high_mult(a, b), utility::low_mult(a, b));
+        }
+
+        void mulmod_array(const UInteger* a, const UInteger* b, UInteger* output, std::size_t size,
+                          std::false_type) const
+        {
+            for (std::size_t i = 0; i != size; ++i) {
+                output[i] = mulmod(a[i], b[i]);
+            }
+        }
+
+        void mulmod_array(const UInteger* a, const UInteger* b, UInteger* output, std::size_t size,
+                          std::true_type) const
+        {
+            switch (active_simd_level()) {
+            case simd_level::avx512:
+            case simd_level::avx2:
+                mulmod_avx2(a, b, output, size);
+                break;
+            default:
+                mulmod_array(a, b, output, size, std::false_type());
+            }
+        }
+
+        FAST_DIVISION_TARGET_AVX2
+        void mulmod_avx2(const UInteger* a, const UInteger* b, UInteger* output, std::size_t size) const
+        {
+            const __m256i divisor = _mm256_set1_epi64x(int64_t(divider_.normalized()));
+            const __m256i reciprocal = _mm256_set1_epi64x(int64_t(divider_.reciprocal()));
+            const __m128i shift = _mm_cvtsi32_si128(int(divider_.shift()));
+            const __m256i pack = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+            std::size_t i = 0;
+            for (; i + 4 <= size; i += 4) {
+                const __m256i x = _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+                const __m256i y = _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+                const __m256i r = detail::barrett_multiply(x, y, divisor, reciprocal, shift);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),
+                                 _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(r, pack)));
+            }
+            mulmod_array(a + i, b + i, output + i, size - i, std::false_type());
+        }
+
+        double_word_divider<UInteger> divider_;
+        constant_divider<product_type, decomposition_policy> product_divider_;
+    };
+
+    /// Arithmetic modulo an invariant odd modulus m in Montgomery form, where x stands for
+    /// x * 2^N modulo m. A product T below m * 2^N is reduced to T / 2^N modulo m by subtracting
+    /// t * m with t = T * m^-1 modulo 2^N, which zeroes the low word, so only multiplications
+    /// remain. Convert with to_montgomery and from_montgomery; addmod, submod, mulmod and powmod
+    /// take and return Montgomery forms, which are below m.
+    template <typename UInteger>
+    class montgomery_modulus {
+    public:
+        static_assert(std::is_unsigned<UInteger>::value, "Modular arithmetic requires an unsigned type");
+
+        using value_type = UInteger;
+
+        constexpr explicit montgomery_modulus(UInteger modulus)
+            : modulus_(modulus), inverse_(utility::modular_inverse(modulus)),
+              one_(UInteger(UInteger(UInteger(0) - modulus) % modulus)), r_squared_(0)
+        {
+            // 2^2N modulo m is the remainder of (2^N mod m, 0).
+            utility::divide_double_word(one_, UInteger(0), modulus, r_squared_);
+        }
+
+        constexpr const UInteger& modulus() const { return modulus_; }
+
+        /// The Montgomery form of 1.
+        constexpr const UInteger& one() const { return one_; }
+
+        constexpr UInteger to_montgomery(UInteger x) const
+        {
+            return reduce(utility::high_mult(x, r_squared_), utility::low_mult(x, r_squared_));
+        }
+
+        constexpr UInteger from_montgomery(UInteger x) const
+        {
+            return reduce(UInteger(0), x);
+        }
+
+        constexpr UInteger addmod(UInteger a, UInteger b) const
+        {
+            return detail::add_mod(a, b, modulus_);
+        }
+
+        constexpr UInteger submod(UInteger a, UInteger b) const
+        {
+            return detail::subtract_mod(a, b, modulus_);
+        }
+
+        constexpr UInteger mulmod(UInteger a, UInteger b) const
+        {
+            return reduce(utility::high_mult(a, b), utility::low_mult(a, b));
+        }
+
+        constexpr UInteger powmod(UInteger base, uint64_t exponent) const
+        {
+            UInteger result = one_;
+            for (; exponent != 0; exponent >>= 1) {
+                if (exponent & 1) {
+                    result = mulmod(result, base);
+                }
+                base = mulmod(base, base);
+            }
+            return result;
+        }
+
+        /// output[i] = a[i] * b[i] in Montgomery form, with SIMD for 32-bit moduli.
+        void mulmod(const UInteger* a, const UInteger* b, UInteger* output, std::size_t size) const
+        {
+            mulmod_array(a, b, output, size, std::is_same<UInteger, uint32_t>());
+        }
+
+    private:
+        /// (high, low) / 2^N modulo m. The low word of t * m equals low, so the difference of
+        /// the high words is the exact quotient, in (-m, m).
+        constexpr UInteger reduce(UInteger high, UInteger low) const
+        {
+            const UInteger t = utility::low_mult(low, inverse_);
+            const UInteger h = utility::high_mult(t, modulus_);
+            return UInteger(UInteger(high - h) + (high < h ? modulus_ : UInteger(0)));
+        }
+
+        void mulmod_array(const UInteger* a, const UInteger* b, UInteger* output, std::size_t size,
+                          std::false_type) const
+        {
+            for (std::size_t i = 0; i != size; ++i) {
+                output[i] = mulmod(a[i], b[i]);
+            }
+        }
+
+        void mulmod_array(const UInteger* a, const UInteger* b, UInteger* output, std::size_t size,
+                          std::true_type) const
+        {
+            switch (active_simd_level()) {
+            case simd_level::avx512:
+            case simd_level::avx2:
+                mulmod_avx2(a, b, output, size);
+                break;
+            case simd_level::sse41:
+                mulmod_sse41(a, b, output, size);
+                break;
+            default:
+                mulmod_array(a, b, output, size, std::false_type());
+            }
+        }
+
+        FAST_DIVISION_TARGET_SSE41
+        void mulmod_sse41(const UInteger* a, const UInteger* b, UInteger* output, std::size_t size) const
+        {
+            const __m128i modulus = _mm_set1_epi32(int32_t(modulus_));
+            const __m128i inverse = _mm_set1_epi32(int32_t(inverse_));
+            std::size_t i = 0;
+            for (; i + 4 <= size; i += 4) {
+                const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+                const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),
+                                 detail::montgomery_multiply(x, y, modulus, inverse));
+            }
+            mulmod_array(a + i, b + i, output + i, size - i, std::false_type());
+        }
+
+        FAST_DIVISION_TARGET_AVX2
+        void mulmod_avx2(const UInteger* a, const UInteger* b, UInteger* output, std::size_t size) const
+        {
+            const __m256i modulus = _mm256_set1_epi32(int32_t(modulus_));
+            const __m256i inverse = _mm256_set1_epi32(int32_t(inverse_));
+            std::size_t i = 0;
+            for (; i + 8 <= size; i += 8) {
+                const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+                const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i),
+                                    detail::montgomery_multiply(x, y, modulus, inverse));
+            }
+            mulmod_array(a + i, b + i, output + i, size - i, std::false_type());
+        }
+
+        UInteger modulus_;
+        UInteger inverse_;
+        UInteger one_;
+        UInteger r_squared_;
+    };
+
+}
@@ -0,0 +1,137 @@
+/**
+ *  Fast Division Library
+ *  Created by Stefan Ivanov
+ *
+ *  Using ideas from
+ *  Division by Invariant Integers Using Multiplication (1994)
+ *  by Torbjörn Granlund, Peter L. Montgomery
+ */
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include <fast_division/fast_division.hpp>
+#include <fast_division/fast_division_base.hpp>
+#include <fast_division/division_policy.hpp>
+#include <fast_division/utility/high_multiplication.hpp>
+
+namespace fast_division {
+
+    /// The constants of constant_divider in a word and a byte, for keeping millions of dividers
+    /// resident, e.g. one per entity. The byte holds the last shift in its low 6 bits, and the
+    /// first shift, which is 0 or 1, or the sign of the divisor in its high bits. The divisor
+    /// itself is not stored, so a 32-bit divider takes 8 bytes instead of 16 and a 64-bit one
+    /// 16 instead of 32. The remainder takes the divisor as an argument, like that of
+    /// constant_divider_base. Decoding costs a mask and a shift of the byte. Only the
+    /// multiplier policies, promotion_policy and decomposition_policy, can be packed.
+    template <typename Integer, template <typename I, bool S> class DivisionPolicy = promotion_policy,
+              bool Signed = std::is_signed<Integer>::value>
+    class packed_divider {
+    public:
+        using base = constant_divider_base<Integer, false, DivisionPolicy>;
+        using value_type = Integer;
+
+        constexpr explicit packed_divider(Integer divisor)
+            : packed_divider(base(divisor))
+        {}
+
+        constexpr explicit packed_divider(const constant_divider<Integer, DivisionPolicy>& divider)
+            : packed_divider(static_cast<const base&>(divider))
+        {}
+
+        constexpr explicit packed_divider(const base& divider)
+            : multiplier_(divider.multiplier_),
+              flags_(uint8_t(divider.shift_2_ | (divider.shift_1_ != 0 ? add_flag : 0)))
+        {}
+
+        constexpr Integer operator()(Integer input) const
+        {
+            Integer t = utility::high_mult(multiplier_, input);
+            return Integer(Integer(t + Integer(Integer(input - t) >> (flags_ >> 6))) >> (flags_ & shift_mask));
+        }
+
+        constexpr Integer remainder(Integer input, Integer divisor) const
+        {
+            return Integer(input - Integer(operator()(input) * divisor));
+        }
+
+        friend constexpr
+        bool operator== (const packed_divider& x, const packed_divider& y)
+        {
+            return x.multiplier_ == y.multiplier_ && x.flags_ == y.flags_;
+        }
+        friend constexpr
+        bool operator!= (const packed_divider& x, const packed_divider& y)
+        {
+            return !(x == y);
+        }
+
+    private:
+        constexpr static const uint8_t shift_mask = 0x3f;
+        constexpr static const uint8_t add_flag = 0x40;
+
+        Integer multiplier_;
+        uint8_t flags_;
+    };
+
+    template <typename Integer, template <typename I, bool S> class DivisionPolicy>
+    class packed_divider<Integer, DivisionPolicy, true> {
+    public:
+        using base = constant_divider_base<Integer, true, DivisionPolicy>;
+        using value_type = Integer;
+
+        constexpr explicit packed_divider(Integer divisor)
+            : packed_divider(base(divisor))
+        {}
+
+        constexpr explicit packed_divider(const constant_divider<Integer, DivisionPolicy>& divider)
+            : packed_divider(static_cast<const base&>(divider))
+        {}
+
+        constexpr explicit packed_divider(const base& divider)
+            : multiplier_(divider.multiplier_),
+              flags_(uint8_t(divider.shift_ | (divider.sign_ != 0 ? negative_flag : 0)))
+        {}
+
+        constexpr Integer operator()(Integer input) const
+        {
+            Integer sign = Integer(-Integer(flags_ >> 7));
+            Integer q = Integer(input + utility::high_mult(multiplier_, input));
+            q = Integer(Integer(q >> (flags_ & shift_mask)) - (input >= 0 ? 0 : -1));
+            return Integer(Integer(q ^ sign) - sign);
+        }
+
+        constexpr Integer remainder(Integer input, Integer divisor) const
+        {
+            return Integer(input - Integer(operator()(input) * divisor));
+        }
+
+        friend constexpr
+        bool operator== (const packed_divider& x, const packed_divider& y)
+        {
+            return x.multiplier_ == y.multiplier_ && x.flags_ == y.flags_;
+        }
+        friend constexpr
+        bool operator!= (const packed_divider& x, const packed_divider& y)
+        {
+            return !(x == y);
+        }
+
+    private:
+        constexpr static const uint8_t shift_mask = 0x3f;
+        constexpr static const uint8_t negative_flag = 0x80;
+
+        Integer multiplier_;
+        uint8_t flags_;
+    };
+
+    template <typename Integer, template <typename, bool> class DivisionPolicy, bool Signed, typename T>
+    inline constexpr
+    Integer operator/ (T&& divident, const packed_divider<Integer, DivisionPolicy, Signed>& divisor)
+    {
+        return divisor(std::forward<T>(divident));
+    }
+
+}
@@ -0,0 +1,237 @@
+/**
+ *  Fast Division Library
+ *  Created by Stefan Ivanov
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fast_division/fast_division.hpp>
+#include <fast_division/fast_division_dispatch.hpp>
+
+namespace fast_division {
+
+    /// Tunables of parallel bulk division.
+    struct parallel_division_settings {
+        /// Arrays smaller than this many bytes are divided on the calling thread, where waking
+        /// the workers would cost more than the division itself.
+        std::size_t min_parallel_bytes = std::size_t(1) << 20;
+        /// Bytes of output per chunk handed to a thread. Rounded down to whole cache lines.
+        std::size_t chunk_bytes = std::size_t(1) << 16;
+    };
+
+    /// A fixed set of worker threads that run the chunks of one loop at a time. The calling
+    /// thread works on chunks too, so a pool of n threads starts n - 1 workers. Chunks are taken
+    /// from a shared atomic counter, so threads that finish early take over the remaining chunks
+    /// of slower ones; for the uniform chunks of a bulk division this balances as well as
+    /// per-thread queues with stealing, at the cost of one atomic increment per chunk.
+    ///
+    /// Loops from different threads are run one after another. A chunk must not start another
+    /// loop on the same pool.
+    class division_pool {
+    public:
+        explicit division_pool(unsigned threads = std::max(1u, std::thread::hardware_concurrency()))
+        {
+            threads = std::max(1u, threads);
+            workers_.reserve(threads - 1);
+            for (unsigned i = 1; i != threads; ++i) {
+                workers_.emplace_back([this] { work(); });
+            }
+        }
+
+        division_pool(const division_pool&) = delete;
+        division_pool& operator=(const division_pool&) = delete;
+
+        ~division_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            wake_.notify_all();
+            for (auto& worker : workers_) {
+                worker.join();
+            }
+        }
+
+        /// Number of threads a loop runs on, the caller included.
+        unsigned concurrency() const { return unsigned(workers_.size()) + 1; }
+
+        /// Call body(i) once for every i in [0, num_chunks) and return when all calls are done.
+        template <typename Body>
+        void run(std::size_t num_chunks, Body& body)
+        {
+            std::lock_guard<std::mutex> serialize(run_mutex_);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                job_ = { &invoke<Body>, &body, num_chunks };
+                next_chunk_.store(0, std::memory_order_relaxed);
+                open_ = true;
+                ++generation_;
+            }
+            wake_.notify_all();
+            take_chunks(job_);
+            // Close the loop so that late workers skip it, then wait for those already in it.
+            std::unique_lock<std::mutex> lock(mutex_);
+            open_ = false;
+            done_.wait(lock, [this] { return active_ == 0; });
+        }
+
+    private:
+        struct job {
+            void (*invoke)(void* body, std::size_t chunk);
+            void* body;
+            std::size_t num_chunks;
+        };
+
+        template <typename Body>
+        static void invoke(void* body, std::size_t chunk)
+        {
+            (*static_cast<Body*>(body))(chunk);
+        }
+
+        void take_chunks(const job& current)
+        {
+            for (;;) {
+                std::size_t chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed);
+                if (chunk >= current.num_chunks) {
+                    return;
+                }
+                current.invoke(current.body, chunk);
+            }
+        }
+
+        void work()
+        {
+            uint64_t seen = 0;
+            std::unique_lock<std::mutex> lock(mutex_);
+            for (;;) {
+                wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+                if (stopping_) {
+                    return;
+                }
+                seen = generation_;
+                if (!open_) {
+                    continue;
+                }
+                job current = job_;
+                ++active_;
+                lock.unlock();
+                take_chunks(current);
+                lock.lock();
+                if (--active_ == 0) {
+                    done_.notify_one();
+                }
+            }
+        }
+
+        std::vector<std::thread> workers_;
+        std::mutex run_mutex_;
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable done_;
+        job job_ = { nullptr, nullptr, 0 };
+        uint64_t generation_ = 0;
+        unsigned active_ = 0;
+        bool open_ = false;
+        bool stopping_ = false;
+        // Written by every thread, so kept off the line of the fields above.
+        alignas(64) std::atomic<std::size_t> next_chunk_{ 0 };
+    };
+
+    /// A pool with one thread per hardware thread, started on first use.
+    inline
+    division_pool& default_division_pool()
+    {
+        static division_pool pool;
+        return pool;
+    }
+
+    namespace detail {
+
+        constexpr std::size_t cache_line_size = 64;
+
+        /// Splits [0, size) into chunks whose inner boundaries are cache line aligned in the
+        /// output, so no two threads ever write to the same line. The first chunk also takes
+        /// the unaligned head.
+        template <typename Integer>
+        class output_chunks {
+        public:
+            output_chunks(const Integer* output, std::size_t size, std::size_t chunk_bytes)
+                : size_(size),
+                  head_(unaligned_head<cache_line_size>(output, size)),
+                  length_(std::max(chunk_bytes / cache_line_size, std::size_t(1)) * cache_line_size / sizeof(Integer))
+            {}
+
+            std::size_t count() const
+            {
+                return std::max((size_ - head_ + length_ - 1) / length_, std::size_t(1));
+            }
+
+            std::size_t begin(std::size_t chunk) const { return chunk == 0 ? 0 : head_ + chunk * length_; }
+
+            std::size_t end(std::size_t chunk) const { return std::min(head_ + (chunk + 1) * length_, size_); }
+
+        private:
+            std::size_t size_;
+            std::size_t head_;
+            std::size_t length_;
+        };
+
+    }
+
+    /// output[i] = input[i] / divider for a large array, split over the threads of pool. Every
+    /// chunk goes through the same SIMD dispatch as constant_divider::divide. Input and output
+    /// may be the same array but must not otherwise overlap.
+    template <typename Integer, template <typename I, bool S> class DivisionPolicy>
+    inline
+    void parallel_divide(const constant_divider<Integer, DivisionPolicy>& divider,
+                         const Integer* input, Integer* output, std::size_t size,
+                         division_pool& pool, const parallel_division_settings& settings = {})
+    {
+        if (size * sizeof(Integer) < settings.min_parallel_bytes || pool.concurrency() == 1) {
+            divider.divide(input, output, size);
+            return;
+        }
+        const detail::output_chunks<Integer> chunks(output, size, settings.chunk_bytes);
+        auto body = [&](std::size_t chunk) {
+            auto begin = chunks.begin(chunk);
+            divider.divide(input + begin, output + begin, chunks.end(chunk) - begin);
+        };
+        pool.run(chunks.count(), body);
+    }
+
+    template <typename Integer, template <typename I, bool S> class DivisionPolicy>
+    inline
+    void parallel_divide(const constant_divider<Integer, DivisionPolicy>& divider,
+                         const Integer* input, Integer* output, std::size_t size,
+                         const parallel_division_settings& settings = {})
+    {
+        parallel_divide(divider, input, output, size, default_division_pool(), settings);
+    }
+
+    template <typename Integer, template <typename I, bool S> class DivisionPolicy>
+    inline
+    void parallel_divide_in_place(const constant_divider<Integer, DivisionPolicy>& divider,
+                                  Integer* data, std::size_t size,
+                                  division_pool& pool, const parallel_division_settings& settings = {})
+    {
+        parallel_divide(divider, data, data, size, pool, settings);
+    }
+
+    template <typename Integer, template <typename I, bool S> class DivisionPolicy>
+    inline
+    void parallel_divide_in_place(const constant_divider<Integer, DivisionPolicy>& divider,
+                                  Integer* data, std::size_t size, const parallel_division_settings& settings = {})
+    {
+        parallel_divide(divider, data, data, size, default_division_pool(), settings);
+    }
+
+}
@@ -0,0 +1,313 @@
+/**
+ *  Fast Division Library
+ *  Created by Stefan Ivanov
+ *
+ *  Using ideas from
+ *  Division by Invariant Integers Using Multiplication (1994)
+ *  by Torbjörn Granlund, Peter L. Montgomery
+ */
+#pragma once
+
+#include <immintrin.h>
+#include <type_traits>
+#include <utility>
+
+#include <fast_division/fast_division.hpp>
+#include <fast_division/fast_division_simd.hpp>
+#include <fast_division/utility/associated_types.hpp>
+#include <fast_division/utility/cpu_features.hpp>
+
+namespace fast_division {
+
+    /// How the quotient of an inexact division is rounded.
+    enum class rounding {
+        toward_zero,    ///< Like the built-in /.
+        floor,          ///< Toward negative infinity.
+        ceil,           ///< Toward positive infinity, e.g. the number of pages for a size.
+        nearest,        ///< To the nearest integer, halves away from zero.
+        euclidean       ///< The remainder is never negative.
+    };
+
+    namespace detail {
+
+        /// The corrections of rounding_divider around the unsigned kernels. The magnitude divider
+        /// is a uint32_t constant_divider_base, whose vector specializations do the division.
+
+        template <typename Divider>
+        inline FAST_DIVISION_TARGET_SSE41
+        __m128i divide_rounded_up_epu32(const Divider& magnitude, __m128i input, uint32_t threshold)
+        {
+            __m128i h = _mm_set1_epi32(int(threshold));
+            __m128i q = _mm_add_epi32(magnitude(_mm_sub_epi32(input, h)), _mm_set1_epi32(1));
+            // input >= h as unsigned integers.
+            __m128i mask = _mm_cmpeq_epi32(_mm_max_epu32(input, h), input);
+            return _mm_and_si128(q, mask);
+        }
+
+        template <typename Divider>
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i divide_rounded_up_epu32(const Divider& magnitude, __m256i input, uint32_t threshold)
+        {
+            __m256i h = _mm256_set1_epi32(int(threshold));
+            __m256i q = _mm256_add_epi32(magnitude(_mm256_sub_epi32(input, h)), _mm256_set1_epi32(1));
+            __m256i mask = _mm256_cmpeq_epi32(_mm256_max_epu32(input, h), input);
+            return _mm256_and_si256(q, mask);
+        }
+
+        template <typename Divider>
+        inline FAST_DIVISION_TARGET_AVX512
+        __m512i divide_rounded_up_epu32(const Divider& magnitude, __m512i input, uint32_t threshold)
+        {
+            __m512i h = _mm512_set1_epi32(int(threshold));
+            __m512i q = _mm512_add_epi32(magnitude(_mm512_sub_epi32(input, h)), _mm512_set1_epi32(1));
+            return _mm512_maskz_mov_epi32(_mm512_cmpge_epu32_mask(input, h), q);
+        }
+
+        template <typename Divider>
+        inline FAST_DIVISION_TARGET_SSE41
+        __m128i divide_biased_epi32(const Divider& magnitude, __m128i input, uint32_t bias_positive,
+                                    uint32_t bias_negative, int32_t sign)
+        {
+            __m128i quotient_sign = _mm_xor_si128(_mm_srai_epi32(input, 31), _mm_set1_epi32(sign));
+            __m128i b_positive = _mm_set1_epi32(int(bias_positive));
+            __m128i b_negative = _mm_set1_epi32(int(bias_negative));
+            __m128i bias = _mm_blendv_epi8(b_positive, b_negative, quotient_sign);
+            // The magnitude of the minimum is 2^31, which is right as an unsigned integer.
+            __m128i q = magnitude(_mm_add_epi32(_mm_abs_epi32(input), bias));
+            return _mm_sub_epi32(_mm_xor_si128(q, quotient_sign), quotient_sign);
+        }
+
+        template <typename Divider>
+        inline FAST_DIVISION_TARGET_AVX2
+        __m256i divide_biased_epi32(const Divider& magnitude, __m256i input, uint32_t bias_positive,
+                                    uint32_t bias_negative, int32_t sign)
+        {
+            __m256i quotient_sign = _mm256_xor_si256(_mm256_srai_epi32(input, 31), _mm256_set1_epi32(sign));
+            __m256i b_positive = _mm256_set1_epi32(int(bias_positive));
+            __m256i b_negative = _mm256_set1_epi32(int(bias_negative));
+            __m256i bias = _mm256_blendv_epi8(b_positive, b_negative, quotient_sign);
+            __m256i q = magnitude(_mm256_add_epi32(_mm256_abs_epi32(input), bias));
+            return _mm256_sub_epi32(_mm256_xor_si256(q, quotient_sign), quotient_sign);
+        }
+
+        template <typename Divider>
+        inline FAST_DIVISION_TARGET_AVX512
+        __m512i divide_biased_epi32(const Divider& magnitude, __m512i input, uint32_t bias_positive,
+                                    uint32_t bias_negative, int32_t sign)
+        {
+            __m512i quotient_sign = _mm512_xor_si512(_mm512_srai_epi32(input, 31), _mm512_set1_epi32(sign));
+            __mmask16 negative = _mm512_cmplt_epi32_mask(quotient_sign, _mm512_setzero_si512());
+            __m512i bias = _mm512_mask_blend_epi32(negative, _mm512_set1_epi32(int(bias_positive)),
+                                                   _mm512_set1_epi32(int(bias_negative)));
+            __m512i q = magnitude(_mm512_add_epi32(_mm512_abs_epi32(input), bias));
+            return _mm512_sub_epi32(_mm512_xor_si512(q, quotient_sign), quotient_sign);
+        }
+
+    }
+
+    /// A divider with a rounding mode other than truncation, where the correction is folded into
+    /// constants computed up front instead of being applied after the division.
+    ///
+    /// Signed dividers divide the magnitude of the dividend by the magnitude of the divisor with an
+    /// unsigned divider. Rounding the magnitude up is adding D - 1 before the division and rounding
+    /// it to nearest is adding D / 2; neither can overflow, since both magnitudes are at most 2^(N-1).
+    /// Which of the two biases to add depends only on the sign of the quotient, so both are stored
+    /// and one is selected with a mask. Euclidean division is floor or ceiling depending on the sign
+    /// of the divisor, which is known at construction.
+    ///
+    /// Unsigned dividers round up by using ceil(n / D) = floor((n - h) / D) + 1 for n >= h and 0
+    /// otherwise, with h = 1 for the ceiling and h = D - D / 2 for the nearest integer. This avoids
+    /// the overflow of adding the bias. Floor and Euclidean division are plain truncation.
+    template <typename Integer, rounding Mode, template <typename I, bool S> class DivisionPolicy = promotion_policy>
+    class rounding_divider {
+    public:
+        constexpr static const auto word_size = sizeof(Integer) * 8;
+        constexpr static const bool is_signed = std::is_signed<Integer>::value;
+        using value_type = Integer;
+        using u_type = std::make_unsigned_t<Integer>;
+        using magnitude_divider = constant_divider_base<u_type, false, DivisionPolicy>;
+
+        constexpr explicit rounding_divider(Integer divisor)
+            : magnitude_(abs(divisor)),
+              divisor_(divisor),
+              bias_positive_(bias(divisor, false)),
+              bias_negative_(bias(divisor, true)),
+              sign_(divisor < 0 ? Integer(-1) : Integer(0))
+        {}
+
+        constexpr const Integer& divisor() const { return divisor_; }
+
+        constexpr Integer operator()(Integer input) const
+        {
+            return divide(input, std::integral_constant<bool, is_signed>{});
+        }
+
+        /// Division of uint32_t and int32_t vectors, by overloads with the target of their width.
+
+        FAST_DIVISION_TARGET_SSE41
+        __m128i operator()(__m128i input) const
+        {
+            return divide(input, std::integral_constant<bool, is_signed>{});
+        }
+
+        FAST_DIVISION_TARGET_AVX2
+        __m256i operator()(__m256i input) const
+        {
+            return divide(input, std::integral_constant<bool, is_signed>{});
+        }
+
+        FAST_DIVISION_TARGET_AVX512
+        __m512i operator()(__m512i input) const
+        {
+            return divide(input, std::integral_constant<bool, is_signed>{});
+        }
+
+        /// input - quotient * divisor, which has the sign the rounding mode implies. Unsigned
+        /// remainders of rounding up are not positive and wrap around.
+        constexpr Integer remainder(Integer input) const
+        {
+            return Integer(u_type(u_type(input) - u_type(u_type(operator()(input)) * u_type(divisor_))));
+        }
+
+        constexpr divmod_result<Integer> divmod(Integer input) const
+        {
+            Integer q = operator()(input);
+            return { q, Integer(u_type(u_type(input) - u_type(u_type(q) * u_type(divisor_)))) };
+        }
+
+        friend constexpr
+        bool operator== (const rounding_divider& x, const rounding_divider& y)
+        {
+            return x.divisor_ == y.divisor_;
+        }
+        friend constexpr
+        bool operator!= (const rounding_divider& x, const rounding_divider& y)
+        {
+            return x.divisor_ != y.divisor_;
+        }
+
+    private:
+        constexpr static const bool rounds_up_unsigned = Mode == rounding::ceil || Mode == rounding::nearest;
+
+        static constexpr u_type abs(Integer divisor)
+        {
+            return divisor < 0 ? u_type(u_type(0) - u_type(divisor)) : u_type(divisor);
+        }
+
+        /// The amount added to the magnitude of the dividend when the quotient has the given sign.
+        /// For unsigned dividers only the positive one is used, and it is stored as h instead.
+        static constexpr u_type bias(Integer divisor, bool negative_quotient)
+        {
+            const u_type d = abs(divisor);
+            const bool euclidean_floor = Mode == rounding::euclidean && !(divisor < 0);
+            const bool up = (Mode == rounding::ceil && !negative_quotient) ||
+                            ((Mode == rounding::floor || euclidean_floor) && negative_quotient) ||
+                            (Mode == rounding::euclidean && !euclidean_floor && !negative_quotient);
+            const u_type b = up ? u_type(d - u_type(1)) : Mode == rounding::nearest ? u_type(d / u_type(2)) : u_type(0);
+            return is_signed || negative_quotient ? b : u_type(d - b);
+        }
+
+        constexpr Integer divide(Integer input, std::false_type) const
+        {
+            if (!rounds_up_unsigned) {
+                return magnitude_(input);
+            }
+            const u_type h = bias_positive_;
+            const u_type mask = u_type(u_type(0) - u_type(input >= h));
+            return Integer(u_type(u_type(magnitude_(u_type(input - h)) + u_type(1)) & mask));
+        }
+
+        constexpr Integer divide(Integer input, std::true_type) const
+        {
+            const u_type input_sign = u_type(Integer(input >> (word_size - 1)));
+            const u_type magnitude = u_type(u_type(u_type(input) ^ input_sign) - input_sign);
+            const u_type quotient_sign = u_type(input_sign ^ u_type(sign_));
+            const u_type bias = u_type(bias_positive_ ^ u_type(u_type(bias_positive_ ^ bias_negative_) & quotient_sign));
+            const u_type q = magnitude_(u_type(magnitude + bias));
+            return Integer(u_type(u_type(q ^ quotient_sign) - quotient_sign));
+        }
+
+        FAST_DIVISION_TARGET_SSE41
+        __m128i divide(__m128i input, std::false_type) const
+        {
+            if (!rounds_up_unsigned) {
+                return magnitude_(input);
+            }
+            return detail::divide_rounded_up_epu32(magnitude_, input, uint32_t(bias_positive_));
+        }
+
+        FAST_DIVISION_TARGET_AVX2
+        __m256i divide(__m256i input, std::false_type) const
+        {
+            if (!rounds_up_unsigned) {
+                return magnitude_(input);
+            }
+            return detail::divide_rounded_up_epu32(magnitude_, input, uint32_t(bias_positive_));
+        }
+
+        FAST_DIVISION_TARGET_AVX512
+        __m512i divide(__m512i input, std::false_type) const
+        {
+            if (!rounds_up_unsigned) {
+                return magnitude_(input);
+            }
+            return detail::divide_rounded_up_epu32(magnitude_, input, uint32_t(bias_positive_));
+        }
+
+        FAST_DIVISION_TARGET_SSE41
+        __m128i divide(__m128i input, std::true_type) const
+        {
+            return detail::divide_biased_epi32(magnitude_, input, uint32_t(bias_positive_),
+                                               uint32_t(bias_negative_), int32_t(sign_));
+        }
+
+        FAST_DIVISION_TARGET_AVX2
+        __m256i divide(__m256i input, std::true_type) const
+        {
+            return detail::divide_biased_epi32(magnitude_, input, uint32_t(bias_positive_),
+                                               uint32_t(bias_negative_), int32_t(sign_));
+        }
+
+        FAST_DIVISION_TARGET_AVX512
+        __m512i divide(__m512i input, std::true_type) const
+        {
+            return detail::divide_biased_epi32(magnitude_, input, uint32_t(bias_positive_),
+                                               uint32_t(bias_negative_), int32_t(sign_));
+        }
+
+        magnitude_divider magnitude_;
+        Integer divisor_;
+        u_type bias_positive_;
+        u_type bias_negative_;
+        Integer sign_;
+    };
+
+    template <typename Integer, rounding Mode, template <typename, bool> class DivisionPolicy, typename T>
+    inline constexpr
+    Integer operator/ (T&& divident, const rounding_divider<Integer, Mode, DivisionPolicy>& divisor)
+    {
+        return divisor(std::forward<T>(divident));
+    }
+
+    template <typename Integer, rounding Mode, template <typename, bool> class DivisionPolicy, typename T>
+    inline constexpr
+    Integer operator% (T&& divident, const rounding_divider<Integer, Mode, DivisionPolicy>& divisor)
+    {
+        return divisor.remainder(std::forward<T>(divident));
+    }
+
+    /// Shorthands for the common modes.
+
+    template <typename Integer, template <typename I, bool S> class DivisionPolicy = promotion_policy>
+    using ceil_divider = rounding_divider<Integer, rounding::ceil, DivisionPolicy>;
+
+    template <typename Integer, template <typename I, bool S> class DivisionPolicy = promotion_policy>
+    using floor_divider = rounding_divider<Integer, rounding::floor, DivisionPolicy>;
+
+    template <typename Integer, template <typename I, bool S> class DivisionPolicy = promotion_policy>
+    using nearest_divider = rounding_divider<Integer, rounding::nearest, DivisionPolicy>;
+
+    template <typename Integer, template <typename I, bool S> class DivisionPolicy = promotion_policy>
+    using euclidean_divider = rounding_divider<Integer, rounding::euclidean, DivisionPolicy>;
+
+}
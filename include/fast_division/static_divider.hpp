@@ -0,0 +1,143 @@
+/**
+ *  Fast Division Library
+ *  Created by Stefan Ivanov
+ *
+ *  Using ideas from
+ *  Division by Invariant Integers Using Multiplication (1994)
+ *  by Torbjörn Granlund, Peter L. Montgomery
+ */
+#pragma once
+
+#include <immintrin.h>
+#include <type_traits>
+#include <utility>
+
+#include <fast_division/fast_division.hpp>
+#include <fast_division/utility/cpu_features.hpp>
+#include <fast_division/utility/log2i.hpp>
+
+namespace fast_division {
+
+    /// A divider whose divisor is a template argument. The multiplier and the shifts are
+    /// computed at compile time and the evaluation sequence is chosen for the divisor,
+    /// so division by 1 or a power of two is a no-op or a single shift.
+    template <typename Integer, Integer Divisor,
+              template <typename I, bool S> class DivisionPolicy = promotion_policy>
+    class static_divider {
+        static_assert(Divisor != 0, "Division by zero");
+
+    public:
+        using base = constant_divider_base<Integer, std::is_signed<Integer>::value, DivisionPolicy>;
+        using value_type = Integer;
+        constexpr static const auto word_size = base::word_size;
+
+        constexpr static Integer divisor() { return Divisor; }
+
+        constexpr Integer operator()(Integer input) const
+        {
+            return divide(input, algorithm{});
+        }
+
+        /// Vectors are divided by overloads with the target of their width, like those of
+        /// constant_divider, so that they are passed in registers of that width.
+
+        FAST_DIVISION_TARGET_SSE41
+        __m128i operator()(__m128i input) const
+        {
+            return divider_(input);
+        }
+
+        FAST_DIVISION_TARGET_AVX2
+        __m256i operator()(__m256i input) const
+        {
+            return divider_(input);
+        }
+
+        FAST_DIVISION_TARGET_AVX512
+        __m512i operator()(__m512i input) const
+        {
+            return divider_(input);
+        }
+
+        constexpr divmod_result<Integer> divmod(Integer input) const
+        {
+            Integer q = operator()(input);
+            return { q, Integer(input - Integer(q * Divisor)) };
+        }
+
+        constexpr Integer remainder(Integer input) const
+        {
+            return Integer(input - Integer(operator()(input) * Divisor));
+        }
+
+    private:
+        using u_type = std::make_unsigned_t<Integer>;
+
+        constexpr static const u_type abs_divisor = Divisor < 0 ? u_type(u_type(0) - u_type(Divisor)) : u_type(Divisor);
+        constexpr static const bool is_power_of_two = (abs_divisor & u_type(abs_divisor - u_type(1))) == 0;
+        constexpr static const unsigned shift = unsigned(utility::log2i(abs_divisor));
+
+        using no_op = std::integral_constant<int, 0>;
+        using negate = std::integral_constant<int, 1>;
+        using power_of_two = std::integral_constant<int, 2>;
+        using multiply = std::integral_constant<int, 3>;
+        using algorithm = std::integral_constant<int,
+            Divisor == Integer(1) ? no_op::value :
+            abs_divisor == u_type(1) ? negate::value :
+            is_power_of_two ? power_of_two::value : multiply::value>;
+
+        constexpr static Integer divide(Integer input, no_op)
+        {
+            return input;
+        }
+
+        constexpr static Integer divide(Integer input, negate)
+        {
+            return Integer(u_type(0) - u_type(input));
+        }
+
+        constexpr static Integer divide(Integer input, power_of_two)
+        {
+            return shift_right(input, std::is_signed<Integer>{});
+        }
+
+        constexpr static Integer divide(Integer input, multiply)
+        {
+            return divider_(input);
+        }
+
+        constexpr static Integer shift_right(Integer input, std::false_type)
+        {
+            return Integer(input >> shift);
+        }
+
+        constexpr static Integer shift_right(Integer input, std::true_type)
+        {
+            // Add 2^k - 1 to negative inputs so that the arithmetic shift truncates towards zero.
+            Integer bias = Integer(u_type(Integer(input >> (word_size - 1))) >> (word_size - shift));
+            Integer q = Integer(Integer(input + bias) >> shift);
+            return Divisor < 0 ? Integer(-q) : q;
+        }
+
+        constexpr static const base divider_{Divisor};
+    };
+
+    template <typename Integer, Integer Divisor, template <typename I, bool S> class DivisionPolicy>
+    constexpr const typename static_divider<Integer, Divisor, DivisionPolicy>::base
+        static_divider<Integer, Divisor, DivisionPolicy>::divider_;
+
+    template <typename Integer, Integer Divisor, template <typename, bool> class DivisionPolicy, typename T>
+    inline constexpr
+    Integer operator/ (T&& divident, const static_divider<Integer, Divisor, DivisionPolicy>& divisor)
+    {
+        return divisor(std::forward<T>(divident));
+    }
+
+    template <typename Integer, Integer Divisor, template <typename, bool> class DivisionPolicy, typename T>
+    inline constexpr
+    Integer operator% (T&& divident, const static_divider<Integer, Divisor, DivisionPolicy>& divisor)
+    {
+        return divisor.remainder(std::forward<T>(divident));
+    }
+
+}
@@ -0,0 +1,201 @@
+/**
+ *  Fast Division Library
+ *  Created by Stefan Ivanov
+ */
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fast_division/fast_division.hpp>
+#include <fast_division/parallel_division.hpp>
+
+namespace fast_division {
+
+    /// Tunables of stream division.
+    struct stream_division_settings {
+        /// Bytes read, divided and written at a time. Three blocks are resident at once: one
+        /// being read ahead, one being divided and one being written behind.
+        std::size_t block_bytes = std::size_t(1) << 22;
+        /// When set, every block is divided by parallel_divide on this pool.
+        division_pool* pool = nullptr;
+    };
+
+    struct stream_division_result {
+        /// Values read, divided and written.
+        uint64_t elements = 0;
+        /// Bytes after the last whole value, which are copied unchanged.
+        std::size_t trailing_bytes = 0;
+        /// A read, write or open failed. The output is incomplete.
+        bool io_error = false;
+
+        explicit operator bool() const { return !io_error && trailing_bytes == 0; }
+    };
+
+    namespace detail {
+
+        /// A blocking queue of buffer indices between the stages of a stream.
+        class block_queue {
+        public:
+            constexpr static const std::size_t end_of_stream = ~std::size_t(0);
+
+            void push(std::size_t block)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    blocks_.push_back(block);
+                }
+                ready_.notify_one();
+            }
+
+            std::size_t pop()
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ready_.wait(lock, [this] { return !blocks_.empty(); });
+                std::size_t block = blocks_.front();
+                blocks_.pop_front();
+                return block;
+            }
+
+        private:
+            std::mutex mutex_;
+            std::condition_variable ready_;
+            std::deque<std::size_t> blocks_;
+        };
+
+    }
+
+    /// Read packed native-endian values from input until its end, divide them and write the
+    /// quotients to output. Reading the next block and writing the previous one run on their own
+    /// threads while the current block is divided, so with fast enough storage the division is
+    /// hidden behind the I/O. Resident memory is three blocks whatever the size of the stream.
+    ///
+    /// input and output may be two handles to the same file positioned at the same offset, which
+    /// divides the file in place: the reader is always ahead of the writer.
+    template <typename Integer, template <typename I, bool S> class DivisionPolicy>
+    inline
+    stream_division_result divide_stream(const constant_divider<Integer, DivisionPolicy>& divider,
+                                         std::FILE* input, std::FILE* output,
+                                         const stream_division_settings& settings = {})
+    {
+        using detail::block_queue;
+        constexpr std::size_t num_blocks = 3;
+        const std::size_t block_elements = std::max(settings.block_bytes / sizeof(Integer), std::size_t(1));
+        std::vector<Integer> buffers[num_blocks];
+        std::size_t bytes[num_blocks] = {};
+        for (auto& buffer : buffers) {
+            buffer.resize(block_elements);
+        }
+
+        block_queue free_blocks, read_blocks, divided_blocks;
+        for (std::size_t i = 0; i != num_blocks; ++i) {
+            free_blocks.push(i);
+        }
+        bool read_error = false;
+        bool write_error = false;
+
+        std::thread reader([&] {
+            for (;;) {
+                std::size_t block = free_blocks.pop();
+                bytes[block] = std::fread(buffers[block].data(), 1, block_elements * sizeof(Integer), input);
+                if (bytes[block] == 0) {
+                    read_error = std::ferror(input) != 0;
+                    read_blocks.push(block_queue::end_of_stream);
+                    return;
+                }
+                read_blocks.push(block);
+            }
+        });
+        std::thread writer([&] {
+            for (;;) {
+                std::size_t block = divided_blocks.pop();
+                if (block == block_queue::end_of_stream) {
+                    write_error |= std::fflush(output) != 0;
+                    return;
+                }
+                // After a failed write the remaining blocks are still drained, so the reader is never left waiting.
+                if (!write_error) {
+                    write_error = std::fwrite(buffers[block].data(), 1, bytes[block], output) != bytes[block];
+                }
+                free_blocks.push(block);
+            }
+        });
+
+        stream_division_result result;
+        for (;;) {
+            std::size_t block = read_blocks.pop();
+            if (block == block_queue::end_of_stream) {
+                divided_blocks.push(block);
+                break;
+            }
+            // Only the last block of a stream can end in part of a value.
+            std::size_t elements = bytes[block] / sizeof(Integer);
+            result.trailing_bytes = bytes[block] % sizeof(Integer);
+            if (settings.pool != nullptr) {
+                parallel_divide_in_place(divider, buffers[block].data(), elements, *settings.pool);
+            }
+            else {
+                divider.divide_in_place(buffers[block].data(), elements);
+            }
+            result.elements += elements;
+            divided_blocks.push(block);
+        }
+        reader.join();
+        writer.join();
+        result.io_error = read_error || write_error;
+        return result;
+    }
+
+    /// Divide the values of the file at input_path and write the quotients to output_path.
+    template <typename Integer, template <typename I, bool S> class DivisionPolicy>
+    inline
+    stream_division_result divide_file(const constant_divider<Integer, DivisionPolicy>& divider,
+                                       const char* input_path, const char* output_path,
+                                       const stream_division_settings& settings = {})
+    {
+        stream_division_result result;
+        std::FILE* input = std::fopen(input_path, "rb");
+        std::FILE* output = input != nullptr ? std::fopen(output_path, "wb") : nullptr;
+        if (output != nullptr) {
+            result = divide_stream(divider, input, output, settings);
+            result.io_error |= std::fclose(output) != 0;
+        }
+        else {
+            result.io_error = true;
+        }
+        if (input != nullptr) {
+            std::fclose(input);
+        }
+        return result;
+    }
+
+    /// Replace every value of the file at path by its quotient.
+    template <typename Integer, template <typename I, bool S> class DivisionPolicy>
+    inline
+    stream_division_result divide_file_in_place(const constant_divider<Integer, DivisionPolicy>& divider,
+                                                const char* path, const stream_division_settings& settings = {})
+    {
+        stream_division_result result;
+        std::FILE* input = std::fopen(path, "rb");
+        std::FILE* output = input != nullptr ? std::fopen(path, "r+b") : nullptr;
+        if (output != nullptr) {
+            result = divide_stream(divider, input, output, settings);
+            result.io_error |= std::fclose(output) != 0;
+        }
+        else {
+            result.io_error = true;
+        }
+        if (input != nullptr) {
+            std::fclose(input);
+        }
+        return result;
+    }
+
+}
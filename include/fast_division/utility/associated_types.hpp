@@ -4,6 +4,10 @@
 */
 #pragma once
 
+#include <cstdint>
+#include <type_traits>
+#include <immintrin.h>
+
 namespace fast_division {
     namespace utility {
 
@@ -28,11 +32,18 @@ namespace fast_division {
         };
 
         /// Helper for determining if a type a SIMD vector.
-        // TODO Add detection of available SIMD types.
+        /// Which of these can be used at runtime is decided by fast_division_dispatch.hpp.
+        /// Found by overload resolution, since naming the vector types as template arguments
+        /// drops their attributes and warns in every translation unit.
+
+        constexpr std::true_type simd_vector_test(const __m128i*) { return {}; }
+        constexpr std::true_type simd_vector_test(const __m256i*) { return {}; }
+        constexpr std::true_type simd_vector_test(const __m512i*) { return {}; }
+        constexpr std::false_type simd_vector_test(const void*) { return {}; }
 
         template <typename T>
         struct is_simd {
-            constexpr static bool value = is_one_of<T, __m128i, __m256i>::value;
+            constexpr static bool value = decltype(simd_vector_test(static_cast<const std::remove_reference_t<T>*>(nullptr)))::value;
         };
 
         /// Promotion for integer types. Must be specialized for user-defined types.
@@ -74,5 +85,21 @@ namespace fast_division {
             using type = int64_t;
         };
 
+        /// 64-bit types are only promotable where the compiler provides a 128-bit integer.
+        /// Elsewhere, use decomposition_policy which needs no wider type.
+    #if defined(__SIZEOF_INT128__)
+        #define FAST_DIVISION_HAS_INT128 1
+
+        template <>
+        struct promotion<uint64_t> {
+            using type = unsigned __int128;
+        };
+
+        template <>
+        struct promotion<int64_t> {
+            using type = __int128;
+        };
+    #endif
+
     }
 }
\ No newline at end of file
@@ -0,0 +1,126 @@
+/**
+ *  Fast Division Library
+ *  Created by Stefan Ivanov
+ */
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__GNUC__)
+#include <cpuid.h>
+#endif
+
+/// Function attributes that enable an instruction set for a single function, so that kernels
+/// can be compiled without enabling the instruction set for the whole translation unit.
+/// MSVC allows intrinsics everywhere and needs no attribute.
+#if defined(__GNUC__)
+    #define FAST_DIVISION_TARGET_SSE41 __attribute__((target("sse4.1")))
+    #define FAST_DIVISION_TARGET_AVX2 __attribute__((target("avx2")))
+    #define FAST_DIVISION_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+    #define FAST_DIVISION_TARGET_SSE41
+    #define FAST_DIVISION_TARGET_AVX2
+    #define FAST_DIVISION_TARGET_AVX512
+#endif
+
+/// Around the AVX-512 kernels: GCC 12 reports the _mm512_undefined_* inside its own intrinsics
+/// as maybe uninitialized once they are inlined (GCC bug 105593), a false positive.
+#if defined(__GNUC__) && !defined(__clang__)
+    #define FAST_DIVISION_AVX512_WARNINGS_PUSH \
+        _Pragma("GCC diagnostic push") _Pragma("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+    #define FAST_DIVISION_AVX512_WARNINGS_POP _Pragma("GCC diagnostic pop")
+#else
+    #define FAST_DIVISION_AVX512_WARNINGS_PUSH
+    #define FAST_DIVISION_AVX512_WARNINGS_POP
+#endif
+
+namespace fast_division {
+
+    /// Instruction set levels for which SIMD division kernels exist, ordered by width.
+    enum class simd_level : int {
+        scalar = 0,
+        sse41 = 1,
+        avx2 = 2,
+        avx512 = 3
+    };
+
+    namespace utility {
+
+        inline
+        void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t (&registers)[4])
+        {
+        #if defined(_MSC_VER)
+            int info[4];
+            __cpuidex(info, int(leaf), int(subleaf));
+            for (int i = 0; i != 4; ++i) {
+                registers[i] = uint32_t(info[i]);
+            }
+        #elif defined(__GNUC__)
+            if (!__get_cpuid_count(leaf, subleaf, &registers[0], &registers[1], &registers[2], &registers[3])) {
+                registers[0] = registers[1] = registers[2] = registers[3] = 0;
+            }
+        #else
+            registers[0] = registers[1] = registers[2] = registers[3] = 0;
+        #endif
+        }
+
+        /// Read the register state the operating system saves on context switches.
+        inline
+        uint64_t xgetbv()
+        {
+        #if defined(_MSC_VER)
+            return _xgetbv(0);
+        #elif defined(__GNUC__)
+            uint32_t low, high;
+            asm volatile("xgetbv" : "=a" (low), "=d" (high) : "c" (0));
+            return (uint64_t(high) << 32) | low;
+        #else
+            return 0;
+        #endif
+        }
+
+        /// Query the processor and the operating system for the widest usable SIMD level.
+        inline
+        simd_level detect_simd_level()
+        {
+            uint32_t leaf_0[4];
+            cpuid(0, 0, leaf_0);
+            const uint32_t max_leaf = leaf_0[0];
+            if (max_leaf < 1) {
+                return simd_level::scalar;
+            }
+
+            uint32_t leaf_1[4];
+            cpuid(1, 0, leaf_1);
+            const bool sse41 = (leaf_1[2] & (1u << 19)) != 0;
+            const bool osxsave = (leaf_1[2] & (1u << 27)) != 0;
+            if (!sse41) {
+                return simd_level::scalar;
+            }
+            if (!osxsave || max_leaf < 7) {
+                return simd_level::sse41;
+            }
+
+            // XMM and YMM state for AVX2, additionally opmask and ZMM state for AVX-512.
+            const uint64_t xcr0 = xgetbv();
+            const bool ymm_state = (xcr0 & 0x6) == 0x6;
+            const bool zmm_state = (xcr0 & 0xE6) == 0xE6;
+
+            uint32_t leaf_7[4];
+            cpuid(7, 0, leaf_7);
+            const bool avx2 = (leaf_7[1] & (1u << 5)) != 0;
+            const bool avx512f = (leaf_7[1] & (1u << 16)) != 0;
+
+            if (avx512f && avx2 && zmm_state) {
+                return simd_level::avx512;
+            }
+            if (avx2 && ymm_state) {
+                return simd_level::avx2;
+            }
+            return simd_level::sse41;
+        }
+
+    }
+}
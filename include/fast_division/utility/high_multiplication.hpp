@@ -4,8 +4,15 @@
  */
 #pragma once
 
+#include <cstdint>
+#include <type_traits>
+
 #include <fast_division/utility/associated_types.hpp>
 
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
 namespace fast_division {
     namespace utility {
 
@@ -79,6 +86,45 @@ namespace fast_division {
                  + low_bits_carry(x,y);
         }
 
+        /// Overloads for 64-bit types. These compile to a single mul/mulx (imul for signed)
+        /// instead of the four partial products of the generic version above.
+
+    #if defined(FAST_DIVISION_HAS_INT128)
+        inline constexpr
+        uint64_t high_mult(uint64_t x, uint64_t y)
+        {
+            return uint64_t((static_cast<unsigned __int128>(x) * y) >> 64);
+        }
+
+        inline constexpr
+        int64_t high_mult(int64_t x, int64_t y)
+        {
+            return int64_t((static_cast<__int128>(x) * y) >> 64);
+        }
+    #elif defined(_MSC_VER) && defined(_M_X64)
+        inline
+        uint64_t high_mult(uint64_t x, uint64_t y)
+        {
+            return __umulh(x, y);
+        }
+
+        inline
+        int64_t high_mult(int64_t x, int64_t y)
+        {
+            return __mulh(x, y);
+        }
+    #endif
+
+        /// Product modulo 2^N of unsigned integers. Narrow types are promoted to int by the
+        /// language, so their product is computed in unsigned to avoid signed overflow.
+        template <typename UInteger>
+        inline constexpr
+        UInteger low_mult(UInteger x, UInteger y)
+        {
+            using w_type = std::common_type_t<UInteger, unsigned>;
+            return UInteger(w_type(x) * w_type(y));
+        }
+
         template <typename Integer>
         inline constexpr
         Integer high_mult_promotion(Integer x, Integer y)
@@ -88,5 +134,15 @@ namespace fast_division {
             //constexpr const auto word_size = 8*sizeof(Integer);
             return  ((static_cast<p_type>(x) * static_cast<p_type>(y)) >> (8 * sizeof(Integer)));
         }
+
+        /// Types narrower than 64 bits have a native promotion, so their high half is a single
+        /// widening multiplication as well.
+
+        inline constexpr uint8_t high_mult(uint8_t x, uint8_t y) { return high_mult_promotion(x, y); }
+        inline constexpr uint16_t high_mult(uint16_t x, uint16_t y) { return high_mult_promotion(x, y); }
+        inline constexpr uint32_t high_mult(uint32_t x, uint32_t y) { return high_mult_promotion(x, y); }
+        inline constexpr int8_t high_mult(int8_t x, int8_t y) { return high_mult_promotion(x, y); }
+        inline constexpr int16_t high_mult(int16_t x, int16_t y) { return high_mult_promotion(x, y); }
+        inline constexpr int32_t high_mult(int32_t x, int32_t y) { return high_mult_promotion(x, y); }
     }
 }
\ No newline at end of file
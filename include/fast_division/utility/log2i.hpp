@@ -5,34 +5,38 @@
 #pragma once
 
 #include <cassert>
+#include <type_traits>
 
 namespace fast_division
 {
     namespace utility
     {
-        /// Efficiently compute the floor of the base-2 logarithm of an unsigned integer
+        /// Efficiently compute the floor of the base-2 logarithm of an unsigned integer.
+        /// Usable in constant expressions, so dividers can be built at compile time.
         template <typename T> 
+        constexpr
         T log2i(T value)
         {
-            assert(value >= 0);
-        #if defined(__GNUC__) && defined(__x86_64__)
-            T result;
-            asm("bsr %1, %0" : "=r" (result) : "r" (value));
-            return result;
-        #elif defined(_WIN32)
-            unsigned long result;
-            if (sizeof(T) <= 4)
-                _BitScanReverse(&result, static_cast<unsigned long>(value));
-            else
-                _BitScanReverse64(&result, static_cast<unsigned long long>(value));
-            return T(result);
+            assert(value > 0);
+        #if defined(__GNUC__)
+            // The builtins compile to bsr/lzcnt and are also evaluated at compile time.
+            return sizeof(T) <= sizeof(unsigned) ?
+                T(8 * sizeof(unsigned) - 1 - unsigned(__builtin_clz(static_cast<unsigned>(value)))) :
+                T(8 * sizeof(unsigned long long) - 1 - unsigned(__builtin_clzll(static_cast<unsigned long long>(value))));
         #else
-            T r = 0;
-            while ((value >> r) != 0)
-                r++;
-            return r - 1;
+            // Binary search for the highest set bit. _BitScanReverse cannot run in a constant expression.
+            using u_type = std::conditional_t<(sizeof(T) <= sizeof(unsigned)), unsigned, unsigned long long>;
+            u_type v = static_cast<u_type>(value);
+            T result = 0;
+            for (unsigned step = 4 * sizeof(u_type); step != 0; step /= 2) {
+                if ((v >> step) != 0) {
+                    v >>= step;
+                    result += T(step);
+                }
+            }
+            return result;
         #endif
-        }     
+        }
 
     }
 }
@@ -0,0 +1,31 @@
+/**
+ *  Fast Division Library
+ *  Created by Stefan Ivanov
+ */
+#pragma once
+
+#include <cassert>
+#include <type_traits>
+
+#include <fast_division/utility/high_multiplication.hpp>
+
+namespace fast_division {
+    namespace utility {
+
+        /// The multiplicative inverse of an odd integer modulo 2^N by Newton's iteration.
+        /// x = d is correct to 3 bits and every step doubles the number of correct bits.
+        template <typename UInteger>
+        inline constexpr
+        UInteger modular_inverse(UInteger odd)
+        {
+            static_assert(std::is_unsigned<UInteger>::value, "The modular inverse requires an unsigned type");
+            assert((odd & 1) == 1);
+            UInteger x = odd;
+            for (unsigned correct_bits = 3; correct_bits < 8 * sizeof(UInteger); correct_bits *= 2) {
+                x = low_mult(x, UInteger(UInteger(2) - low_mult(odd, x)));
+            }
+            return x;
+        }
+
+    }
+}
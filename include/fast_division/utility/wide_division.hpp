@@ -0,0 +1,105 @@
+/**
+ *  Fast Division Library
+ *  Created by Stefan Ivanov
+ *
+ *  Using ideas from
+ *  Hacker's Delight (2nd edition), section 9-4
+ *  by Henry S. Warren, Jr.
+ */
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+#include <fast_division/utility/log2i.hpp>
+
+namespace fast_division {
+    namespace utility {
+
+        /// Divide the double-word unsigned integer (high, low) by divisor without a wider type.
+        /// The division is decomposed into two steps of dividing a word by a half-word digit
+        /// (Knuth's algorithm D with base 2^(N/2)). Requires high < divisor so that the quotient
+        /// fits in a single word. The remainder is stored in the last argument.
+        template <typename UInteger>
+        inline constexpr
+        UInteger divide_double_word(UInteger high, UInteger low, UInteger divisor, UInteger& remainder)
+        {
+            static_assert(std::is_unsigned<UInteger>::value, "Double-word division requires an unsigned type");
+            constexpr unsigned word_size = 8 * sizeof(UInteger);
+            constexpr unsigned half_size = word_size / 2;
+            constexpr UInteger base = UInteger(UInteger(1) << half_size);
+            constexpr UInteger half_mask = UInteger(base - UInteger(1));
+
+            // Normalize so that the most significant bit of the divisor is set.
+            const unsigned s = word_size - 1 - unsigned(log2i(std::common_type_t<UInteger, unsigned>(divisor)));
+            const UInteger v = UInteger(divisor << s);
+            const UInteger v_1 = UInteger(v >> half_size);
+            const UInteger v_0 = UInteger(v & half_mask);
+
+            const UInteger u_32 = s == 0 ? high : UInteger(UInteger(high << s) | UInteger(low >> (word_size - s)));
+            const UInteger u_10 = UInteger(low << s);
+            const UInteger u_1 = UInteger(u_10 >> half_size);
+            const UInteger u_0 = UInteger(u_10 & half_mask);
+
+            // First quotient digit. The estimate is at most two too large.
+            UInteger q_1 = UInteger(u_32 / v_1);
+            UInteger r_hat = UInteger(u_32 - UInteger(q_1 * v_1));
+            while (q_1 >= base || UInteger(q_1 * v_0) > UInteger(UInteger(r_hat << half_size) | u_1)) {
+                --q_1;
+                r_hat = UInteger(r_hat + v_1);
+                if (r_hat >= base) {
+                    break;
+                }
+            }
+
+            // Second quotient digit from the partial remainder.
+            const UInteger u_21 = UInteger(UInteger(UInteger(u_32 << half_size) | u_1) - UInteger(q_1 * v));
+            UInteger q_0 = UInteger(u_21 / v_1);
+            r_hat = UInteger(u_21 - UInteger(q_0 * v_1));
+            while (q_0 >= base || UInteger(q_0 * v_0) > UInteger(UInteger(r_hat << half_size) | u_0)) {
+                --q_0;
+                r_hat = UInteger(r_hat + v_1);
+                if (r_hat >= base) {
+                    break;
+                }
+            }
+
+            remainder = UInteger(UInteger(UInteger(UInteger(u_21 << half_size) | u_0) - UInteger(q_0 * v)) >> s);
+            return UInteger(UInteger(q_1 << half_size) | q_0);
+        }
+
+        template <typename UInteger>
+        inline constexpr
+        UInteger divide_double_word(UInteger high, UInteger low, UInteger divisor)
+        {
+            UInteger remainder = 0;
+            return divide_double_word(high, low, divisor, remainder);
+        }
+
+        /// The same division with the 128 by 64-bit divide instruction where there is one, which
+        /// does the whole division at once instead of the four half-word steps above. Not usable
+        /// in constant expressions. Requires high < divisor, or the instruction faults.
+        inline
+        uint64_t divide_double_word_native(uint64_t high, uint64_t low, uint64_t divisor)
+        {
+        #if defined(__GNUC__) && defined(__x86_64__)
+            uint64_t quotient = 0;
+            uint64_t remainder = 0;
+            __asm__("divq %[divisor]"
+                    : "=a"(quotient), "=d"(remainder)
+                    : [divisor] "r"(divisor), "a"(low), "d"(high));
+            return quotient;
+        #elif defined(_MSC_VER) && defined(_M_X64) && _MSC_VER >= 1920
+            uint64_t remainder = 0;
+            return _udiv128(high, low, divisor, &remainder);
+        #else
+            return divide_double_word(high, low, divisor);
+        #endif
+        }
+
+    }
+}
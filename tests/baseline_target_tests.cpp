@@ -0,0 +1,191 @@
+// Built without -mavx2, unlike fast_division_tests, so that the SIMD kernels are reached from code
+// compiled for the baseline instruction set only, as in most users' builds. Vectors passed between
+// functions without the target of their width change the ABI there, which the other tests hide.
+
+#include <cstdint>
+#include <array>
+#include <random>
+#include <vector>
+#include <immintrin.h>
+
+#include <fast_division/fast_division.hpp>
+#include <fast_division/hash_buckets.hpp>
+#include <fast_division/mixed_radix.hpp>
+#include <fast_division/rounding_divider.hpp>
+#include <fast_division/static_divider.hpp>
+
+namespace {
+
+    template<typename Integer>
+    std::vector<Integer> random_values(std::size_t size, std::mt19937_64& generator)
+    {
+        std::vector<Integer> values(size);
+        for (auto& v : values) {
+            v = Integer(generator());
+        }
+        return values;
+    }
+
+    template<typename Integer>
+    bool divide_array_impl(Integer divisor, std::mt19937_64& generator)
+    {
+        const fast_division::constant_divider<Integer> divider(divisor);
+        const auto input = random_values<Integer>(generator() % 200, generator);
+        std::vector<Integer> output(input.size());
+        divider.divide(input.data(), output.data(), input.size());
+        bool is_correct = true;
+        for (std::size_t i = 0; i != input.size(); ++i) {
+            is_correct &= output[i] == Integer(input[i] / divisor);
+        }
+        return is_correct;
+    }
+
+    template<typename Integer>
+    bool mixed_radix_impl(const std::array<Integer, 2>& radices, std::mt19937_64& generator)
+    {
+        const fast_division::mixed_radix<Integer, 2> grid(radices);
+        const auto indices = random_values<Integer>(generator() % 200, generator);
+        std::array<std::vector<Integer>, 3> digits;
+        for (auto& digit : digits) {
+            digit.resize(indices.size());
+        }
+        const std::array<Integer*, 3> digit_pointers = { { digits[0].data(), digits[1].data(), digits[2].data() } };
+        grid.decompose(indices.data(), indices.size(), digit_pointers.data());
+        bool is_correct = true;
+        for (std::size_t i = 0; i != indices.size(); ++i) {
+            const Integer n = indices[i];
+            is_correct &= digits[0][i] == Integer(n % radices[0]);
+            is_correct &= digits[1][i] == Integer(Integer(n / radices[0]) % radices[1]);
+            is_correct &= digits[2][i] == Integer(Integer(n / radices[0]) / radices[1]);
+        }
+        return is_correct;
+    }
+
+    bool prime_buckets_impl(std::size_t min_buckets, std::mt19937_64& generator)
+    {
+        const fast_division::prime_buckets<uint32_t> buckets(min_buckets);
+        const auto hashes = random_values<uint32_t>(generator() % 200, generator);
+        std::vector<uint32_t> indices(hashes.size());
+        buckets.indices(hashes.data(), indices.data(), hashes.size());
+        bool is_correct = true;
+        for (std::size_t i = 0; i != hashes.size(); ++i) {
+            is_correct &= indices[i] == hashes[i] % buckets.bucket_count();
+        }
+        return is_correct;
+    }
+
+    /// The vector members of constant_divider called from a function with the AVX2 target.
+    FAST_DIVISION_TARGET_AVX2
+    bool divmod_avx2_impl(uint32_t divisor, std::mt19937_64& generator)
+    {
+        const fast_division::constant_divider<uint32_t> divider(divisor);
+        const auto input = random_values<uint32_t>(8, generator);
+        __m256i n = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.data()));
+        auto qr = divider.divmod(n);
+        __m256i r = divider.remainder(n);
+        __m256i q = divider(n);
+        uint32_t quotients[8], remainders[8], single_remainders[8], single_quotients[8];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(quotients), qr.quotient);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(remainders), qr.remainder);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(single_remainders), r);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(single_quotients), q);
+        bool is_correct = true;
+        for (int i = 0; i != 8; ++i) {
+            is_correct &= quotients[i] == input[i] / divisor && single_quotients[i] == quotients[i];
+            is_correct &= remainders[i] == input[i] % divisor && single_remainders[i] == remainders[i];
+        }
+        return is_correct;
+    }
+
+    /// Eight lanes of a divider with vector overloads of its own, against its scalar division.
+    template<typename Divider, typename Integer>
+    FAST_DIVISION_TARGET_AVX2
+    bool vector_divider_avx2(const Divider& divider, const Integer* input)
+    {
+        Integer quotients[8];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(quotients),
+                            divider(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input))));
+        bool is_correct = true;
+        for (int i = 0; i != 8; ++i) {
+            is_correct &= quotients[i] == divider(input[i]);
+        }
+        return is_correct;
+    }
+
+    template<typename Divider, typename Integer>
+    FAST_DIVISION_TARGET_SSE41
+    bool vector_divider_sse41(const Divider& divider, const Integer* input)
+    {
+        Integer quotients[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(quotients),
+                         divider(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input))));
+        bool is_correct = true;
+        for (int i = 0; i != 4; ++i) {
+            is_correct &= quotients[i] == divider(input[i]);
+        }
+        return is_correct;
+    }
+
+    template<typename Divider, typename Integer>
+    bool vector_divider_impl(const Divider& divider, const Integer* input)
+    {
+        const auto level = fast_division::detected_simd_level();
+        return (level < fast_division::simd_level::sse41 || vector_divider_sse41(divider, input)) &&
+               (level < fast_division::simd_level::avx2 || vector_divider_avx2(divider, input));
+    }
+
+    /// static_divider and rounding_divider, whose vector overloads forward to the kernels.
+    bool vector_dividers_impl(std::mt19937_64& generator)
+    {
+        using fast_division::rounding;
+        const uint32_t edges[] = { 0, 1, 6, 7, 8, 100, 1000, 0xffffffffu };
+        const int32_t signed_edges[] = { 0, 1, -6, 7, -8, 100, -1000, 2147483647 };
+        const auto values = random_values<uint32_t>(8, generator);
+        std::vector<int32_t> signed_values(values.begin(), values.end());
+        bool is_correct = true;
+        for (const uint32_t* input : { edges, values.data() }) {
+            is_correct &= vector_divider_impl(fast_division::static_divider<uint32_t, 7>{}, input);
+            is_correct &= vector_divider_impl(fast_division::static_divider<uint32_t, 641>{}, input);
+            is_correct &= vector_divider_impl(fast_division::rounding_divider<uint32_t, rounding::ceil>(7), input);
+            is_correct &= vector_divider_impl(fast_division::rounding_divider<uint32_t, rounding::nearest>(10), input);
+        }
+        for (const int32_t* input : { signed_edges, static_cast<const int32_t*>(signed_values.data()) }) {
+            is_correct &= vector_divider_impl(fast_division::static_divider<int32_t, -7>{}, input);
+            is_correct &= vector_divider_impl(fast_division::rounding_divider<int32_t, rounding::ceil>(7), input);
+            is_correct &= vector_divider_impl(fast_division::rounding_divider<int32_t, rounding::floor>(-3), input);
+            is_correct &= vector_divider_impl(fast_division::rounding_divider<int32_t, rounding::euclidean>(-10), input);
+        }
+        return is_correct;
+    }
+
+}
+
+int main()
+{
+    using fast_division::simd_level;
+    std::mt19937_64 generator(29);
+    bool is_correct = true;
+    for (auto level : { simd_level::scalar, simd_level::sse41, simd_level::avx2, simd_level::avx512 }) {
+        if (fast_division::force_simd_level(level) != level) {
+            continue;
+        }
+        for (int i = 0; i != 100; ++i) {
+            const uint32_t d = uint32_t(generator() >> (generator() % 64)) | 1u;
+            is_correct &= divide_array_impl<uint32_t>(d, generator);
+            is_correct &= divide_array_impl<int32_t>(int32_t(d), generator);
+            is_correct &= divide_array_impl<uint16_t>(uint16_t(d | 1u), generator);
+            is_correct &= mixed_radix_impl<uint32_t>({ { 640, 480 } }, generator);
+            is_correct &= mixed_radix_impl<uint32_t>({ { d, uint32_t(generator() % 1000 + 1) } }, generator);
+            is_correct &= mixed_radix_impl<int32_t>({ { 37, 23 } }, generator);
+            is_correct &= mixed_radix_impl<uint16_t>({ { 60, 60 } }, generator);
+            is_correct &= mixed_radix_impl<uint8_t>({ { 7, 3 } }, generator);
+            is_correct &= prime_buckets_impl(std::size_t(generator() % 100000), generator);
+            if (fast_division::detected_simd_level() >= simd_level::avx2) {
+                is_correct &= divmod_avx2_impl(d, generator);
+            }
+            is_correct &= vector_dividers_impl(generator);
+        }
+    }
+    fast_division::reset_simd_level();
+    return !is_correct;
+}
@@ -1,18 +1,43 @@
 #include "fast_division_tests.hpp"
 
 #include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <array>
 #include <vector>
 #include <immintrin.h>
 #include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
 
 #include <fast_division/fast_division.hpp>
 #include <fast_division/fast_division_base.hpp>
 #include <fast_division/fast_division_simd.hpp>
+#include <fast_division/static_divider.hpp>
+#include <fast_division/exact_divider.hpp>
+#include <fast_division/branchfree_divider.hpp>
+#include <fast_division/rounding_divider.hpp>
+#include <fast_division/divider_cache.hpp>
+#include <fast_division/divider_table.hpp>
+#include <fast_division/parallel_division.hpp>
+#include <fast_division/stream_division.hpp>
+#include <fast_division/integer_format.hpp>
+#include <fast_division/hash_buckets.hpp>
+#include <fast_division/divider_batch.hpp>
+#include <fast_division/packed_divider.hpp>
+#include <fast_division/double_word_divider.hpp>
+#include <fast_division/limb_division.hpp>
+#include <fast_division/modular_arithmetic.hpp>
+#include <fast_division/mixed_radix.hpp>
+#include <fast_division/division_statistics.hpp>
 #include <fast_division/utility/associated_types.hpp>
 #include <fast_division/division_policy.hpp>
 
 namespace fd_t = fast_division::tests;
 
+using fast_division::constant_divider;
+
 namespace {
 
     template<typename Integer, typename  SizeType = uint64_t>
@@ -48,7 +73,8 @@ namespace {
         uint16_t, std::conditional_t<std::is_same<int8_t, T>::value,
                                      int16_t, T> >;
 
-    template<typename Integer, typename DivisionPolicy = fast_division::promotion_policy, typename SizeType = uint64_t>
+    template<typename Integer, template <typename, bool> class DivisionPolicy = fast_division::promotion_policy,
+             typename SizeType = uint64_t>
     bool random_division_impl(SizeType num_divisors, SizeType divisions_per_divisor)
     {
         using namespace  std;
@@ -76,6 +102,74 @@ namespace {
                 if(result != expected) {
                     is_correct = false;
                 }
+                auto qr = divider.divmod(dividend);
+                Integer expected_remainder = dividend % divisor_;
+                if (qr.quotient != expected || qr.remainder != expected_remainder ||
+                    (dividend % divider) != expected_remainder) {
+                    is_correct = false;
+                }
+                --current_divisions;
+            }
+            --num_divisors;
+        }
+        return is_correct;
+    }
+
+
+
+    template<typename Integer, typename Simd,
+             template <typename, bool> class DivisionPolicy = fast_division::promotion_policy,
+             typename SizeType = uint64_t>
+    bool random_simd_division_impl(SizeType num_divisors, SizeType divisions_per_divisor)
+    {
+        using namespace  std;
+        using namespace fast_division;
+        constexpr auto lanes = sizeof(Simd) / sizeof(Integer);
+        bool is_correct = true;
+        random_device rd;
+        mt19937 dividend_generator(rd());
+        mt19937 divisor_generator(rd());
+        uniform_int_distribution<distribution_t<Integer>> dividend_distribution(
+            numeric_limits<Integer>::min(), numeric_limits<Integer>::max());
+        uniform_int_distribution<distribution_t<Integer>> divisor_distribution(
+            numeric_limits<Integer>::min(), numeric_limits<Integer>::max());
+        Integer dividends[lanes];
+        Integer check[lanes];
+        while (num_divisors) {
+            Integer divisor_ = static_cast<Integer>(divisor_distribution(divisor_generator));
+            // Skip division by zero.
+            if (divisor_ == Integer(0)) {
+                continue;
+            }
+            constant_divider<Integer, DivisionPolicy> divider(divisor_);
+            auto current_divisions = divisions_per_divisor;
+            while (current_divisions) {
+                for (auto& dividend : dividends) {
+                    dividend = static_cast<Integer>(dividend_distribution(dividend_generator));
+                    // Skip the only overflowing signed division.
+                    if (divisor_ == Integer(-1) && dividend == numeric_limits<Integer>::min()) {
+                        dividend = Integer(0);
+                    }
+                }
+                Simd n;
+                memcpy(&n, dividends, sizeof(Simd));
+                Simd q = divider(n);
+                memcpy(check, &q, sizeof(Simd));
+                auto qr = divider.divmod(n);
+                Integer check_quotient[lanes];
+                Integer check_remainder[lanes];
+                Integer check_remainder_only[lanes];
+                memcpy(check_quotient, &qr.quotient, sizeof(Simd));
+                memcpy(check_remainder, &qr.remainder, sizeof(Simd));
+                Simd r = divider.remainder(n);
+                memcpy(check_remainder_only, &r, sizeof(Simd));
+                for (size_t i = 0; i != lanes; ++i) {
+                    Integer expected_remainder = Integer(dividends[i] % divisor_);
+                    if (check[i] != Integer(dividends[i] / divisor_) || check_quotient[i] != check[i] ||
+                        check_remainder[i] != expected_remainder || check_remainder_only[i] != expected_remainder) {
+                        is_correct = false;
+                    }
+                }
                 --current_divisions;
             }
             --num_divisors;
@@ -83,7 +177,468 @@ namespace {
         return is_correct;
     }
 
+    /// Every divisor against every dividend, for the 8-bit vector kernels.
+    template<typename Integer, typename Simd,
+             template <typename, bool> class DivisionPolicy = fast_division::promotion_policy>
+    bool exhaustive_simd_division_impl()
+    {
+        using namespace std;
+        constexpr auto lanes = sizeof(Simd) / sizeof(Integer);
+        constexpr int count = 1 << (8 * sizeof(Integer));
+        static_assert(count % lanes == 0, "The dividends must fill whole vectors");
+        bool is_correct = true;
+        Integer dividends[count];
+        Integer quotients[count];
+        Integer remainders[count];
+        for (int i = 0; i != count; ++i) {
+            dividends[i] = static_cast<Integer>(numeric_limits<Integer>::min() + i);
+        }
+        for (int d = numeric_limits<Integer>::min(); d <= numeric_limits<Integer>::max(); ++d) {
+            if (d == 0) {
+                continue;
+            }
+            constant_divider<Integer, DivisionPolicy> divider(static_cast<Integer>(d));
+            for (size_t i = 0; i != count; i += lanes) {
+                Simd n;
+                memcpy(&n, dividends + i, sizeof(Simd));
+                auto qr = divider.divmod(n);
+                memcpy(quotients + i, &qr.quotient, sizeof(Simd));
+                memcpy(remainders + i, &qr.remainder, sizeof(Simd));
+            }
+            for (int i = 0; i != count; ++i) {
+                // The overflowing min / -1 wraps around, like the scalar division.
+                is_correct &= quotients[i] == Integer(dividends[i] / d) && remainders[i] == Integer(dividends[i] % d);
+            }
+        }
+        return is_correct;
+    }
+
+    template<typename Integer, template <typename, bool> class DivisionPolicy = fast_division::promotion_policy>
+    bool bulk_division_impl(std::size_t num_divisors, std::size_t max_size)
+    {
+        using namespace  std;
+        using namespace fast_division;
+        bool is_correct = true;
+        random_device rd;
+        mt19937 generator(rd());
+        uniform_int_distribution<distribution_t<Integer>> distribution(
+            numeric_limits<Integer>::min(), numeric_limits<Integer>::max());
+        uniform_int_distribution<std::size_t> size_distribution(0, max_size);
+        while (num_divisors) {
+            Integer divisor_ = static_cast<Integer>(distribution(generator));
+            if (divisor_ == Integer(0)) {
+                continue;
+            }
+            constant_divider<Integer, DivisionPolicy> divider(divisor_);
+            auto size = size_distribution(generator);
+            // Start at a random element so that heads of every length are exercised.
+            auto offset = size_distribution(generator) % 16;
+            vector<Integer> dividends(offset + size);
+            for (auto& dividend : dividends) {
+                dividend = static_cast<Integer>(distribution(generator));
+                if (divisor_ == Integer(-1) && dividend == numeric_limits<Integer>::min()) {
+                    dividend = Integer(0);
+                }
+            }
+            vector<Integer> quotients(offset + size);
+            divider.divide(dividends.data() + offset, quotients.data() + offset, size);
+            vector<Integer> in_place(dividends);
+            divider.divide_in_place(in_place.data() + offset, size);
+            for (std::size_t i = offset; i != dividends.size(); ++i) {
+                Integer expected = Integer(dividends[i] / divisor_);
+                if (quotients[i] != expected || in_place[i] != expected) {
+                    is_correct = false;
+                }
+            }
+            // The range overloads.
+            divider.divide(dividends, quotients);
+            divider.divide_in_place(dividends);
+            is_correct &= dividends == quotients;
+            --num_divisors;
+        }
+        return is_correct;
+    }
+
+    template<typename Integer, Integer Divisor, typename SizeType = uint64_t>
+    bool random_static_division_impl(SizeType num_divisions)
+    {
+        using namespace  std;
+        using namespace fast_division;
+        bool is_correct = true;
+        random_device rd;
+        mt19937 generator(rd());
+        uniform_int_distribution<distribution_t<Integer>> dividend_distribution(
+            numeric_limits<Integer>::min(), numeric_limits<Integer>::max());
+        constexpr static_divider<Integer, Divisor> divider{};
+        constexpr static_divider<Integer, Divisor, decomposition_policy> decomposition_divider{};
+        // Edge values first, then random ones.
+        Integer edges[] = { numeric_limits<Integer>::min(), numeric_limits<Integer>::max(), Integer(0), Integer(1),
+                            Integer(Divisor), Integer(make_unsigned_t<Integer>(Divisor) - 1u),
+                            Integer(make_unsigned_t<Integer>(Divisor) + 1u) };
+        auto check = [&](Integer dividend) {
+            if (Divisor == Integer(-1) && dividend == numeric_limits<Integer>::min()) {
+                return;
+            }
+            Integer expected = Integer(dividend / Divisor);
+            Integer expected_remainder = Integer(dividend % Divisor);
+            if (divider(dividend) != expected || decomposition_divider(dividend) != expected ||
+                (dividend / divider) != expected || (dividend % divider) != expected_remainder ||
+                divider.divmod(dividend).remainder != expected_remainder) {
+                is_correct = false;
+            }
+        };
+        for (auto dividend : edges) {
+            check(dividend);
+        }
+        while (num_divisions) {
+            check(static_cast<Integer>(dividend_distribution(generator)));
+            --num_divisions;
+        }
+        return is_correct;
+    }
+
+    template<typename Integer, Integer... Divisors>
+    bool random_static_division(uint64_t num_divisions)
+    {
+        bool results[] = { random_static_division_impl<Integer, Divisors>(num_divisions)... };
+        for (auto result : results) {
+            if (!result) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<typename Integer>
+    bool check_exact_division(const fast_division::exact_divider<Integer>& divider, Integer dividend)
+    {
+        using namespace std;
+        Integer divisor = divider.divisor();
+        if (divisor == Integer(-1) && dividend == numeric_limits<Integer>::min()) {
+            return true;
+        }
+        bool is_multiple = Integer(dividend % divisor) == 0;
+        if (divider.divides(dividend) != is_multiple || divisible_by(dividend, divider) != is_multiple) {
+            return false;
+        }
+        // Round towards zero to the closest multiple, which is always representable.
+        Integer multiple = Integer(dividend - Integer(dividend % divisor));
+        return divider(multiple) == Integer(multiple / divisor);
+    }
+
+    template<typename Integer>
+    bool exhaustive_exact_division_impl()
+    {
+        using namespace std;
+        bool is_correct = true;
+        for (int d = numeric_limits<Integer>::min(); d <= numeric_limits<Integer>::max(); ++d) {
+            if (d == 0) {
+                continue;
+            }
+            fast_division::exact_divider<Integer> divider(static_cast<Integer>(d));
+            for (int n = numeric_limits<Integer>::min(); n <= numeric_limits<Integer>::max(); ++n) {
+                is_correct &= check_exact_division(divider, static_cast<Integer>(n));
+            }
+        }
+        return is_correct;
+    }
+
+    template<typename Integer, typename SizeType = uint64_t>
+    bool random_exact_division_impl(SizeType num_divisors, SizeType divisions_per_divisor)
+    {
+        using namespace std;
+        bool is_correct = true;
+        random_device rd;
+        mt19937 generator(rd());
+        uniform_int_distribution<distribution_t<Integer>> distribution(
+            numeric_limits<Integer>::min(), numeric_limits<Integer>::max());
+        uniform_int_distribution<int> shift_distribution(0, 8 * sizeof(Integer) - 1);
+        while (num_divisors) {
+            // Shift right by a random amount so that small and even divisors are common.
+            Integer divisor = static_cast<Integer>(distribution(generator) >> shift_distribution(generator));
+            if (divisor == Integer(0)) {
+                continue;
+            }
+            fast_division::exact_divider<Integer> divider(divisor);
+            for (auto i = divisions_per_divisor; i != 0; --i) {
+                is_correct &= check_exact_division(divider, static_cast<Integer>(distribution(generator)));
+                // Multiples of the divisor, which random dividends rarely are.
+                Integer quotient = static_cast<Integer>(distribution(generator) >> shift_distribution(generator));
+                is_correct &= check_exact_division(divider, Integer(quotient * divisor));
+            }
+            --num_divisors;
+        }
+        return is_correct;
+    }
+
+    template<typename Integer>
+    bool exhaustive_branchfree_division_impl()
+    {
+        using namespace std;
+        bool is_correct = true;
+        for (int d = numeric_limits<Integer>::min(); d <= numeric_limits<Integer>::max(); ++d) {
+            if (d == 0) {
+                continue;
+            }
+            fast_division::branchfree_divider<Integer> divider(static_cast<Integer>(d));
+            for (int n = numeric_limits<Integer>::min(); n <= numeric_limits<Integer>::max(); ++n) {
+                if (d == -1 && n == numeric_limits<Integer>::min()) {
+                    continue;
+                }
+                is_correct &= divider(static_cast<Integer>(n)) == static_cast<Integer>(n / d);
+            }
+        }
+        return is_correct;
+    }
+
+    template<typename Integer, typename SizeType = uint64_t>
+    bool random_branchfree_division_impl(SizeType num_divisors, SizeType divisions_per_divisor)
+    {
+        using namespace std;
+        bool is_correct = true;
+        random_device rd;
+        mt19937 generator(rd());
+        uniform_int_distribution<distribution_t<Integer>> distribution(
+            numeric_limits<Integer>::min(), numeric_limits<Integer>::max());
+        uniform_int_distribution<int> shift_distribution(0, 8 * sizeof(Integer) - 1);
+        while (num_divisors) {
+            // Shift right by a random amount so that 1 and powers of two are common.
+            Integer divisor = static_cast<Integer>(distribution(generator) >> shift_distribution(generator));
+            if (divisor == Integer(0)) {
+                continue;
+            }
+            fast_division::branchfree_divider<Integer> divider(divisor);
+            for (auto i = divisions_per_divisor; i != 0; --i) {
+                Integer n = static_cast<Integer>(distribution(generator));
+                if (divisor == Integer(-1) && n == numeric_limits<Integer>::min()) {
+                    continue;
+                }
+                is_correct &= divider(n) == Integer(n / divisor) && n % divider == Integer(n % divisor);
+            }
+            --num_divisors;
+        }
+        return is_correct;
+    }
+
+    template<typename Integer, typename Simd, typename SizeType = uint64_t>
+    bool random_branchfree_simd_division_impl(SizeType num_divisors, SizeType divisions_per_divisor)
+    {
+        using namespace std;
+        constexpr auto lanes = sizeof(Simd) / sizeof(Integer);
+        bool is_correct = true;
+        random_device rd;
+        mt19937 generator(rd());
+        uniform_int_distribution<Integer> distribution(numeric_limits<Integer>::min(), numeric_limits<Integer>::max());
+        uniform_int_distribution<int> shift_distribution(0, 31);
+        Integer dividends[lanes];
+        Integer quotients[lanes];
+        while (num_divisors) {
+            Integer divisor = Integer(distribution(generator) >> shift_distribution(generator));
+            if (divisor == Integer(0) || divisor == Integer(-1)) {
+                continue;
+            }
+            fast_division::branchfree_divider<Integer> divider(divisor);
+            for (auto i = divisions_per_divisor; i != 0; --i) {
+                for (size_t j = 0; j != lanes; ++j) {
+                    dividends[j] = distribution(generator);
+                }
+                Simd n;
+                memcpy(&n, dividends, sizeof(Simd));
+                Simd q = divider(n);
+                memcpy(quotients, &q, sizeof(Simd));
+                for (size_t j = 0; j != lanes; ++j) {
+                    is_correct &= quotients[j] == dividends[j] / divisor;
+                }
+            }
+            --num_divisors;
+        }
+        return is_correct;
+    }
+
+    /// The quotient with the given rounding, corrected from the built-in truncating division.
+    template<typename Integer>
+    Integer reference_rounded_division(Integer n, Integer d, fast_division::rounding mode)
+    {
+        using fast_division::rounding;
+        using u_type = std::make_unsigned_t<Integer>;
+        Integer q = Integer(n / d);
+        Integer r = Integer(n % d);
+        if (r == 0) {
+            return q;
+        }
+        // Which way the exact quotient lies from the truncated one.
+        bool positive = (r < 0) == (d < 0);
+        Integer away = positive ? Integer(1) : Integer(-1);
+        u_type abs_r = r < 0 ? u_type(u_type(0) - u_type(r)) : u_type(r);
+        u_type abs_d = d < 0 ? u_type(u_type(0) - u_type(d)) : u_type(d);
+        switch (mode) {
+        case rounding::toward_zero:
+            return q;
+        case rounding::floor:
+            return positive ? q : Integer(q - 1);
+        case rounding::ceil:
+            return positive ? Integer(q + 1) : q;
+        case rounding::nearest:
+            return abs_r >= u_type(abs_d - abs_r) ? Integer(q + away) : q;
+        default:
+            return r > 0 ? q : d > 0 ? Integer(q - 1) : Integer(q + 1);
+        }
+    }
+
+    template<typename Integer, fast_division::rounding Mode>
+    bool check_rounded_division(const fast_division::rounding_divider<Integer, Mode>& divider, Integer n)
+    {
+        Integer d = divider.divisor();
+        if (d == Integer(-1) && n == std::numeric_limits<Integer>::min()) {
+            return true;
+        }
+        Integer expected = reference_rounded_division(n, d, Mode);
+        auto qr = divider.divmod(n);
+        return divider(n) == expected && qr.quotient == expected &&
+               qr.remainder == Integer(n - Integer(expected * d)) && n % divider == qr.remainder;
+    }
+
+    template<typename Integer, fast_division::rounding Mode>
+    bool exhaustive_rounded_division_impl()
+    {
+        using namespace std;
+        bool is_correct = true;
+        for (int d = numeric_limits<Integer>::min(); d <= numeric_limits<Integer>::max(); ++d) {
+            if (d == 0) {
+                continue;
+            }
+            fast_division::rounding_divider<Integer, Mode> divider(static_cast<Integer>(d));
+            for (int n = numeric_limits<Integer>::min(); n <= numeric_limits<Integer>::max(); ++n) {
+                is_correct &= check_rounded_division(divider, static_cast<Integer>(n));
+            }
+        }
+        return is_correct;
+    }
+
+    template<typename Integer, fast_division::rounding Mode, typename SizeType = uint64_t>
+    bool random_rounded_division_impl(SizeType num_divisors, SizeType divisions_per_divisor)
+    {
+        using namespace std;
+        bool is_correct = true;
+        random_device rd;
+        mt19937 generator(rd());
+        uniform_int_distribution<distribution_t<Integer>> distribution(
+            numeric_limits<Integer>::min(), numeric_limits<Integer>::max());
+        uniform_int_distribution<int> shift_distribution(0, 8 * sizeof(Integer) - 1);
+        while (num_divisors) {
+            Integer divisor = static_cast<Integer>(distribution(generator) >> shift_distribution(generator));
+            if (divisor == Integer(0)) {
+                continue;
+            }
+            fast_division::rounding_divider<Integer, Mode> divider(divisor);
+            for (auto i = divisions_per_divisor; i != 0; --i) {
+                is_correct &= check_rounded_division(divider, static_cast<Integer>(distribution(generator)));
+            }
+            // The extremes, where adding a bias would overflow.
+            is_correct &= check_rounded_division(divider, numeric_limits<Integer>::max());
+            is_correct &= check_rounded_division(divider, numeric_limits<Integer>::min());
+            --num_divisors;
+        }
+        return is_correct;
+    }
+
+    template<typename Integer, typename Simd, fast_division::rounding Mode, typename SizeType = uint64_t>
+    bool random_rounded_simd_division_impl(SizeType num_divisors, SizeType divisions_per_divisor)
+    {
+        using namespace std;
+        constexpr auto lanes = sizeof(Simd) / sizeof(Integer);
+        bool is_correct = true;
+        random_device rd;
+        mt19937 generator(rd());
+        uniform_int_distribution<Integer> distribution(numeric_limits<Integer>::min(), numeric_limits<Integer>::max());
+        uniform_int_distribution<int> shift_distribution(0, 31);
+        Integer dividends[lanes];
+        Integer quotients[lanes];
+        while (num_divisors) {
+            Integer divisor = Integer(distribution(generator) >> shift_distribution(generator));
+            if (divisor == Integer(0) || divisor == Integer(-1)) {
+                continue;
+            }
+            fast_division::rounding_divider<Integer, Mode> divider(divisor);
+            for (auto i = divisions_per_divisor; i != 0; --i) {
+                for (size_t j = 0; j != lanes; ++j) {
+                    dividends[j] = distribution(generator);
+                }
+                dividends[0] = numeric_limits<Integer>::max();
+                dividends[1] = numeric_limits<Integer>::min();
+                Simd n;
+                memcpy(&n, dividends, sizeof(Simd));
+                Simd q = divider(n);
+                memcpy(quotients, &q, sizeof(Simd));
+                for (size_t j = 0; j != lanes; ++j) {
+                    is_correct &= quotients[j] == reference_rounded_division(dividends[j], divisor, Mode);
+                }
+            }
+            --num_divisors;
+        }
+        return is_correct;
+    }
+
+    template<fast_division::rounding Mode>
+    bool rounded_division_impl()
+    {
+        return exhaustive_rounded_division_impl<uint8_t, Mode>() &&
+               exhaustive_rounded_division_impl<int8_t, Mode>() &&
+               random_rounded_division_impl<uint16_t, Mode>(1000, 1000) &&
+               random_rounded_division_impl<int16_t, Mode>(1000, 1000) &&
+               random_rounded_division_impl<uint32_t, Mode>(1000, 1000) &&
+               random_rounded_division_impl<int32_t, Mode>(1000, 1000) &&
+               random_rounded_division_impl<uint64_t, Mode>(1000, 1000) &&
+               random_rounded_division_impl<int64_t, Mode>(1000, 1000) &&
+               random_rounded_simd_division_impl<uint32_t, __m128i, Mode>(1000, 100) &&
+               random_rounded_simd_division_impl<int32_t, __m128i, Mode>(1000, 100) &&
+               random_rounded_simd_division_impl<uint32_t, __m256i, Mode>(1000, 100) &&
+               random_rounded_simd_division_impl<int32_t, __m256i, Mode>(1000, 100);
+    }
 
+    template<typename Integer, typename Simd, typename SizeType = uint64_t>
+    bool random_exact_simd_division_impl(SizeType num_divisors, SizeType divisions_per_divisor)
+    {
+        using namespace std;
+        constexpr auto lanes = sizeof(Simd) / sizeof(Integer);
+        bool is_correct = true;
+        random_device rd;
+        mt19937 generator(rd());
+        uniform_int_distribution<Integer> distribution(numeric_limits<Integer>::min(), numeric_limits<Integer>::max());
+        uniform_int_distribution<int> shift_distribution(0, 31);
+        Integer dividends[lanes];
+        Integer quotients[lanes];
+        Integer mask[lanes];
+        while (num_divisors) {
+            Integer divisor = Integer(distribution(generator) >> shift_distribution(generator));
+            if (divisor == Integer(0) || divisor == Integer(-1)) {
+                continue;
+            }
+            fast_division::exact_divider<Integer> divider(divisor);
+            for (auto i = divisions_per_divisor; i != 0; --i) {
+                for (size_t j = 0; j != lanes; ++j) {
+                    // Every other lane is a multiple of the divisor.
+                    Integer n = distribution(generator);
+                    dividends[j] = j % 2 ? Integer(n - Integer(n % divisor)) : n;
+                }
+                Simd n;
+                memcpy(&n, dividends, sizeof(Simd));
+                Simd q = divider(n);
+                Simd m = divider.divides(n);
+                memcpy(quotients, &q, sizeof(Simd));
+                memcpy(mask, &m, sizeof(Simd));
+                for (size_t j = 0; j != lanes; ++j) {
+                    bool is_multiple = dividends[j] % divisor == 0;
+                    is_correct &= (mask[j] == Integer(-1)) == is_multiple && (mask[j] == 0) != is_multiple;
+                    if (is_multiple) {
+                        is_correct &= quotients[j] == dividends[j] / divisor;
+                    }
+                }
+            }
+            --num_divisors;
+        }
+        return is_correct;
+    }
 
     template<typename Integer, typename DoubleWordInteger = fast_division::utility::promotion_t<Integer>,
              typename SizeType = uint64_t>
@@ -101,8 +656,10 @@ namespace {
             Integer m1 = static_cast<Integer>(integer_distribution(generator));
             Integer m2 = static_cast<Integer>(integer_distribution(generator));
             Integer result = utility::high_mult(m1, m2);
+            // The generic partial product version, which the overloads bypass.
+            Integer generic_result = utility::high_mult<Integer>(m1, m2);
             Integer expected = (DoubleWordInteger(m1) * DoubleWordInteger(m2)) >> (8 * sizeof(Integer));
-            if (result != expected) {
+            if (result != expected || generic_result != expected) {
                 is_correct = false;
             }
             --num_multiplication;
@@ -219,8 +776,10 @@ bool fd_t::random_unsigned_division()
     auto uint16_test = random_division_impl<uint16_t>(10000, 10000);
     // Test for uint32_t
     auto uint32_test = random_division_impl<uint32_t>(100000, 10000);
-    
-    return uint8_test && uint16_test && uint32_test;
+    // Test for uint64_t
+    auto uint64_test = random_division_impl<uint64_t>(100000, 1000);
+
+    return uint8_test && uint16_test && uint32_test && uint64_test;
 }
 
 bool fd_t::random_signed_division()
@@ -232,8 +791,10 @@ bool fd_t::random_signed_division()
     auto int16_test = random_division_impl<int16_t>(10000, 10000);
     // Test for uint32_t
     auto int32_test = random_division_impl<int32_t>(100000, 10000);
+    // Test for int64_t
+    auto int64_test = random_division_impl<int64_t>(100000, 1000);
 
-    return int8_test && int16_test && int32_test;
+    return int8_test && int16_test && int32_test && int64_test;
 
 }
 
@@ -253,6 +814,1412 @@ bool fd_t::high_multiplication()
     auto int16_test = high_division_impl<int16_t>(1000);
     // Test for int32_t
     auto int32_test = high_division_impl<int32_t>(10000);
-    return uint8_test && uint16_test && uint32_test &&
-           int8_test && int16_test && int32_test;
-}
\ No newline at end of file
+#if defined(FAST_DIVISION_HAS_INT128)
+    // Test for uint64_t
+    auto uint64_test = high_division_impl<uint64_t>(10000);
+    // Test for int64_t
+    auto int64_test = high_division_impl<int64_t>(10000);
+#else
+    auto uint64_test = true;
+    auto int64_test = true;
+#endif
+    return uint8_test && uint16_test && uint32_test && uint64_test &&
+           int8_test && int16_test && int32_test && int64_test;
+}
+
+bool fd_t::random_decomposition_division()
+{
+    using fast_division::decomposition_policy;
+    auto uint8_test = random_division_impl<uint8_t, decomposition_policy>(1000, 1000);
+    auto uint16_test = random_division_impl<uint16_t, decomposition_policy>(10000, 1000);
+    auto uint32_test = random_division_impl<uint32_t, decomposition_policy>(10000, 1000);
+    auto uint64_test = random_division_impl<uint64_t, decomposition_policy>(10000, 1000);
+    auto int8_test = random_division_impl<int8_t, decomposition_policy>(1000, 1000);
+    auto int16_test = random_division_impl<int16_t, decomposition_policy>(10000, 1000);
+    auto int32_test = random_division_impl<int32_t, decomposition_policy>(10000, 1000);
+    auto int64_test = random_division_impl<int64_t, decomposition_policy>(10000, 1000);
+
+    return uint8_test && uint16_test && uint32_test && uint64_test &&
+           int8_test && int16_test && int32_test && int64_test;
+}
+
+
+bool fd_t::division_random_simd_avx(uint32_t num_divisors, uint32_t divisions_per_divisor)
+{
+    using fast_division::decomposition_policy;
+    auto sse_test = random_simd_division_impl<uint32_t, __m128i, decomposition_policy>(num_divisors, divisions_per_divisor);
+    auto avx_test = random_simd_division_impl<uint32_t, __m256i>(num_divisors, divisions_per_divisor);
+    auto avx_decomposition_test = random_simd_division_impl<uint32_t, __m256i, decomposition_policy>(
+        num_divisors, divisions_per_divisor);
+    return sse_test && avx_test && avx_decomposition_test;
+}
+
+bool fd_t::division_random_signed_simd(uint32_t num_divisors, uint32_t divisions_per_divisor)
+{
+    using fast_division::decomposition_policy;
+    auto sse_test = random_simd_division_impl<int32_t, __m128i>(num_divisors, divisions_per_divisor);
+    auto sse_decomposition_test = random_simd_division_impl<int32_t, __m128i, decomposition_policy>(
+        num_divisors, divisions_per_divisor);
+    auto avx_test = random_simd_division_impl<int32_t, __m256i>(num_divisors, divisions_per_divisor);
+    auto avx_decomposition_test = random_simd_division_impl<int32_t, __m256i, decomposition_policy>(
+        num_divisors, divisions_per_divisor);
+    // Small divisors of both signs, including +-1 and powers of two.
+    bool small_test = true;
+    for (int32_t d = -300; d <= 300; ++d) {
+        if (d == 0) {
+            continue;
+        }
+        fast_division::constant_divider<int32_t> divider(d);
+        int32_t dividends[8] = { std::numeric_limits<int32_t>::max(), -1, 0, 1, -7, 7,
+                                 std::numeric_limits<int32_t>::min() + 1, d };
+        int32_t check[8];
+        __m256i q = divider(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(dividends)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(check), q);
+        for (int i = 0; i != 8; ++i) {
+            if (check[i] != dividends[i] / d) {
+                small_test = false;
+            }
+        }
+    }
+    return sse_test && sse_decomposition_test && avx_test && avx_decomposition_test && small_test;
+}
+
+
+bool fd_t::dispatched_division()
+{
+    using fast_division::simd_level;
+    using fast_division::decomposition_policy;
+    bool is_correct = true;
+    for (auto level : { simd_level::scalar, simd_level::sse41, simd_level::avx2, simd_level::avx512 }) {
+        // Forcing is clamped to what the machine supports, which is always a valid level to test.
+        fast_division::force_simd_level(level);
+        is_correct &= bulk_division_impl<uint32_t>(300, 300);
+        is_correct &= bulk_division_impl<int32_t>(300, 300);
+        is_correct &= bulk_division_impl<uint32_t, decomposition_policy>(100, 100);
+        is_correct &= bulk_division_impl<int32_t, decomposition_policy>(100, 100);
+        is_correct &= bulk_division_impl<uint64_t>(100, 100);
+        is_correct &= bulk_division_impl<int16_t>(100, 100);
+        is_correct &= bulk_division_impl<uint16_t, decomposition_policy>(100, 300);
+        is_correct &= bulk_division_impl<uint8_t>(100, 300);
+        is_correct &= bulk_division_impl<int8_t>(100, 300);
+    }
+    fast_division::reset_simd_level();
+    is_correct &= fast_division::active_simd_level() == fast_division::detected_simd_level();
+    return is_correct;
+}
+
+
+namespace {
+
+    // Dividers must be constructible and usable in constant expressions.
+    constexpr std::array<constant_divider<uint32_t>, 4> shard_dividers{ {
+        constant_divider<uint32_t>(1), constant_divider<uint32_t>(16),
+        constant_divider<uint32_t>(7), constant_divider<uint32_t>(1000000007) } };
+    static_assert(shard_dividers[0](12345) == 12345, "Compile time division by 1");
+    static_assert(shard_dividers[1](12345) == 12345 / 16, "Compile time division by a power of two");
+    static_assert(shard_dividers[2].divmod(12345).remainder == 12345 % 7, "Compile time remainder");
+    static_assert(shard_dividers[3](4000000000u) == 4000000000u / 1000000007, "Compile time division");
+    static_assert(constant_divider<int16_t, fast_division::decomposition_policy>(-7)(int16_t(-100)) == -100 / -7,
+                  "Compile time signed division");
+    static_assert(fast_division::static_divider<int32_t, -8>{}(-17) == -17 / -8, "Static signed shift");
+#if defined(FAST_DIVISION_HAS_INT128)
+    static_assert(constant_divider<uint64_t>(10)(uint64_t(-1)) == uint64_t(-1) / 10, "Compile time 64-bit division");
+#endif
+
+}
+
+bool fd_t::static_division()
+{
+    auto uint8_test = random_static_division<uint8_t, 1, 2, 3, 7, 10, 128, 255>(10000);
+    auto uint16_test = random_static_division<uint16_t, 1, 2, 7, 100, 1024, 65535>(10000);
+    auto uint32_test = random_static_division<uint32_t, 1, 2, 3, 10, 1u << 31, 641, 4294967295u>(100000);
+    auto uint64_test = random_static_division<uint64_t, 1, 2, 10, 1ull << 63, 1000000007, ~0ull>(100000);
+    auto int8_test = random_static_division<int8_t, 1, -1, 2, -2, 3, -7, 64, -128, 127>(10000);
+    auto int16_test = random_static_division<int16_t, 1, -1, 4, -4, 7, -100, -32768>(10000);
+    auto int32_test = random_static_division<int32_t, 1, -1, 2, -8, 3, -10, 1 << 30, -2147483647 - 1>(100000);
+    auto int64_test = random_static_division<int64_t, 1, -1, 2, -1024, 7, -1000000007>(100000);
+
+    bool table_test = true;
+    for (uint32_t n = 0; n != 100000; ++n) {
+        for (auto& divider : shard_dividers) {
+            table_test &= divider(n) == n / divider.divisor();
+        }
+    }
+    return uint8_test && uint16_test && uint32_test && uint64_test &&
+           int8_test && int16_test && int32_test && int64_test && table_test;
+}
+
+
+bool fd_t::exact_division()
+{
+    auto uint8_test = exhaustive_exact_division_impl<uint8_t>();
+    auto int8_test = exhaustive_exact_division_impl<int8_t>();
+    auto uint16_test = random_exact_division_impl<uint16_t>(10000, 1000);
+    auto int16_test = random_exact_division_impl<int16_t>(10000, 1000);
+    auto uint32_test = random_exact_division_impl<uint32_t>(10000, 1000);
+    auto int32_test = random_exact_division_impl<int32_t>(10000, 1000);
+    auto uint64_test = random_exact_division_impl<uint64_t>(10000, 1000);
+    auto int64_test = random_exact_division_impl<int64_t>(10000, 1000);
+    auto simd_test = random_exact_simd_division_impl<uint32_t, __m128i>(1000, 1000) &&
+                     random_exact_simd_division_impl<int32_t, __m128i>(1000, 1000) &&
+                     random_exact_simd_division_impl<uint32_t, __m256i>(1000, 1000) &&
+                     random_exact_simd_division_impl<int32_t, __m256i>(1000, 1000);
+    static_assert(fast_division::exact_divider<uint32_t>(24)(240) == 10, "Compile time exact division");
+    static_assert(!fast_division::exact_divider<int32_t>(-6).divides(-20), "Compile time divisibility");
+    return uint8_test && int8_test && uint16_test && int16_test && uint32_test && int32_test &&
+           uint64_test && int64_test && simd_test;
+}
+
+
+bool fd_t::random_fastmod_division()
+{
+    using fast_division::fastmod_policy;
+    auto uint8_test = random_division_impl<uint8_t, fastmod_policy>(1000, 1000);
+    auto uint16_test = random_division_impl<uint16_t, fastmod_policy>(10000, 1000);
+    auto uint32_test = random_division_impl<uint32_t, fastmod_policy>(10000, 1000);
+    auto int8_test = random_division_impl<int8_t, fastmod_policy>(1000, 1000);
+    auto int16_test = random_division_impl<int16_t, fastmod_policy>(10000, 1000);
+    auto int32_test = random_division_impl<int32_t, fastmod_policy>(10000, 1000);
+    // Divisors of magnitude 1 and the minimum, which the reciprocal handles specially.
+    bool edge_test = true;
+    for (int32_t d : { 1, -1, std::numeric_limits<int32_t>::min(), 2, -2, 3 }) {
+        constant_divider<int32_t, fastmod_policy> divider(d);
+        for (int32_t n : { std::numeric_limits<int32_t>::min() + 1, -7, -1, 0, 1, 7,
+                           std::numeric_limits<int32_t>::max() }) {
+            edge_test &= divider(n) == n / d && divider.remainder(n) == n % d;
+        }
+        edge_test &= divider.remainder(std::numeric_limits<int32_t>::min()) == 
+                     (d == -1 ? 0 : std::numeric_limits<int32_t>::min() % d);
+    }
+    constant_divider<uint32_t, fastmod_policy> one(1);
+    edge_test &= one(4294967295u) == 4294967295u && one.remainder(4294967295u) == 0;
+    edge_test &= constant_divider<int32_t, fastmod_policy>(1)(std::numeric_limits<int32_t>::min()) ==
+                 std::numeric_limits<int32_t>::min();
+
+    return uint8_test && uint16_test && uint32_test && int8_test && int16_test && int32_test && edge_test;
+}
+
+
+bool fd_t::cached_division()
+{
+    using namespace std;
+    using fast_division::divider_cache;
+    bool is_correct = true;
+
+    // Single thread: the first lookup misses, the following ones hit.
+    divider_cache<uint32_t> cache(64);
+    is_correct &= cache.capacity() == 64;
+    for (uint32_t d = 1; d != 33; ++d) {
+        is_correct &= !cache.contains(d);
+        is_correct &= cache.get(d)(1000000) == 1000000 / d;
+    }
+    for (int round = 0; round != 3; ++round) {
+        for (uint32_t d = 1; d != 33; ++d) {
+            auto divider = cache.get(d);
+            is_correct &= divider.divisor() == d && divider(4294967295u) == 4294967295u / d;
+        }
+    }
+    auto stats = cache.statistics();
+    // Some sets may be full before others, so a few of the 32 divisors can be evicted again.
+    is_correct &= stats.hits + stats.misses == 128 && stats.misses >= 32 && stats.hits >= 64;
+
+    // The size stays bounded when there are more divisors than slots.
+    divider_cache<int64_t> small_cache(8);
+    for (int64_t d = 1; d != 1000; ++d) {
+        is_correct &= small_cache.get(-d)(-1000000) == -1000000 / -d;
+    }
+    stats = small_cache.statistics();
+    is_correct &= stats.insertions - stats.evictions <= small_cache.capacity();
+
+    // Many readers with concurrent inserts and evictions must always get the right divider.
+    divider_cache<uint32_t, fast_division::fastmod_policy> shared_cache(256);
+    atomic<bool> threads_correct(true);
+    vector<thread> threads;
+    for (unsigned t = 0; t != 4; ++t) {
+        threads.emplace_back([&shared_cache, &threads_correct, t]() {
+            mt19937 generator(t);
+            // A skewed divisor distribution, so that a hot set is read while cold ones churn.
+            uniform_int_distribution<uint32_t> hot(1, 100);
+            uniform_int_distribution<uint32_t> cold(1, 100000);
+            uniform_int_distribution<uint32_t> dividends;
+            bool thread_correct = true;
+            for (int i = 0; i != 200000; ++i) {
+                uint32_t d = i % 4 ? hot(generator) : cold(generator);
+                uint32_t n = dividends(generator);
+                auto divider = shared_cache.get(d);
+                thread_correct &= divider(n) == n / d && divider.remainder(n) == n % d;
+            }
+            if (!thread_correct) {
+                threads_correct = false;
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    stats = shared_cache.statistics();
+    is_correct &= threads_correct && stats.hits + stats.misses == 800000 && stats.hits > stats.misses;
+    return is_correct;
+}
+
+
+bool fd_t::branchfree_division()
+{
+    using fast_division::branchfree_divider;
+    auto uint8_test = exhaustive_branchfree_division_impl<uint8_t>();
+    auto int8_test = exhaustive_branchfree_division_impl<int8_t>();
+    auto uint16_test = random_branchfree_division_impl<uint16_t>(10000, 1000);
+    auto int16_test = random_branchfree_division_impl<int16_t>(10000, 1000);
+    auto uint32_test = random_branchfree_division_impl<uint32_t>(10000, 1000);
+    auto int32_test = random_branchfree_division_impl<int32_t>(10000, 1000);
+    auto uint64_test = random_branchfree_division_impl<uint64_t>(10000, 1000);
+    auto int64_test = random_branchfree_division_impl<int64_t>(10000, 1000);
+    auto simd_test = random_branchfree_simd_division_impl<uint32_t, __m128i>(1000, 1000) &&
+                     random_branchfree_simd_division_impl<int32_t, __m128i>(1000, 1000) &&
+                     random_branchfree_simd_division_impl<uint32_t, __m256i>(1000, 1000) &&
+                     random_branchfree_simd_division_impl<int32_t, __m256i>(1000, 1000);
+    // The divisors the uniform sequence has to absorb without special cases.
+    bool edge_test = true;
+    for (uint32_t d : { 1u, 2u, 1u << 31, 4294967295u }) {
+        branchfree_divider<uint32_t> divider(d);
+        for (uint32_t n : { 0u, 1u, 2u, 4294967294u, 4294967295u }) {
+            edge_test &= divider(n) == n / d;
+        }
+    }
+    edge_test &= branchfree_divider<int32_t>(1)(std::numeric_limits<int32_t>::min()) == std::numeric_limits<int32_t>::min();
+    edge_test &= branchfree_divider<int32_t>(std::numeric_limits<int32_t>::min())(std::numeric_limits<int32_t>::min()) == 1;
+    static_assert(branchfree_divider<uint32_t>(1)(7) == 7, "Compile time branch-free division");
+    static_assert(branchfree_divider<int32_t, fast_division::decomposition_policy>(-8)(-65) == 8, "Compile time branch-free division");
+    return uint8_test && int8_test && uint16_test && int16_test && uint32_test && int32_test &&
+           uint64_test && int64_test && simd_test && edge_test;
+}
+
+
+bool fd_t::rounded_division()
+{
+    using fast_division::rounding;
+    auto toward_zero_test = rounded_division_impl<rounding::toward_zero>();
+    auto floor_test = rounded_division_impl<rounding::floor>();
+    auto ceil_test = rounded_division_impl<rounding::ceil>();
+    auto nearest_test = rounded_division_impl<rounding::nearest>();
+    auto euclidean_test = rounded_division_impl<rounding::euclidean>();
+    static_assert(fast_division::ceil_divider<uint32_t>(4096)(4097) == 2, "Compile time ceiling division");
+    static_assert(fast_division::euclidean_divider<int32_t>(60)(-1) == -1, "Compile time Euclidean division");
+    static_assert(fast_division::euclidean_divider<int32_t>(60).remainder(-1) == 59, "Compile time Euclidean remainder");
+    return toward_zero_test && floor_test && ceil_test && nearest_test && euclidean_test;
+}
+
+
+bool fd_t::division_narrow_simd()
+{
+    using fast_division::decomposition_policy;
+    auto uint8_test = exhaustive_simd_division_impl<uint8_t, __m128i>() &&
+                      exhaustive_simd_division_impl<uint8_t, __m256i, decomposition_policy>();
+    auto int8_test = exhaustive_simd_division_impl<int8_t, __m128i>() &&
+                     exhaustive_simd_division_impl<int8_t, __m256i, decomposition_policy>();
+    auto uint16_test = random_simd_division_impl<uint16_t, __m128i>(3000, 100) &&
+                       random_simd_division_impl<uint16_t, __m256i, decomposition_policy>(3000, 100);
+    auto int16_test = random_simd_division_impl<int16_t, __m128i, decomposition_policy>(3000, 100) &&
+                      random_simd_division_impl<int16_t, __m256i>(3000, 100);
+    return uint8_test && int8_test && uint16_test && int16_test;
+}
+
+
+namespace {
+
+    template<typename Integer, template <typename I, bool S> class Policy = fast_division::promotion_policy,
+             typename SizeType = uint64_t>
+    bool table_division_impl(SizeType divisor_count, SizeType division_count)
+    {
+        using namespace std;
+        const size_t num_divisors = size_t(divisor_count);
+        const size_t num_divisions = size_t(division_count);
+        bool is_correct = true;
+        random_device rd;
+        mt19937 generator(rd());
+        uniform_int_distribution<distribution_t<Integer>> distribution(
+            numeric_limits<Integer>::min(), numeric_limits<Integer>::max());
+        uniform_int_distribution<int> shift_distribution(0, 8 * sizeof(Integer) - 1);
+        uniform_int_distribution<uint32_t> index_distribution(0, uint32_t(num_divisors - 1));
+        // A divisor of -1 is kept, so the minimum is not divided to avoid the overflow.
+        auto dividend = [&]() {
+            Integer n;
+            do {
+                n = static_cast<Integer>(distribution(generator));
+            } while (n == numeric_limits<Integer>::min() && is_signed<Integer>::value);
+            return n;
+        };
+        fast_division::divider_table<Integer, Policy> table;
+        while (table.size() != num_divisors) {
+            Integer divisor = static_cast<Integer>(distribution(generator) >> shift_distribution(generator));
+            if (divisor != Integer(0)) {
+                table.push_back(divisor);
+            }
+        }
+        // An odd size leaves a scalar tail after the vector loops.
+        vector<Integer> dividends(num_divisors);
+        vector<Integer> quotients(num_divisors);
+        for (auto& n : dividends) {
+            n = dividend();
+        }
+        table.divide(dividends.data(), quotients.data(), dividends.size());
+        for (size_t i = 0; i != dividends.size(); ++i) {
+            is_correct &= quotients[i] == Integer(dividends[i] / table.divisor(i));
+        }
+        vector<uint32_t> indices(num_divisions);
+        dividends.resize(num_divisions);
+        quotients.resize(num_divisions);
+        for (size_t i = 0; i != num_divisions; ++i) {
+            indices[i] = index_distribution(generator);
+            dividends[i] = dividend();
+        }
+        table.divide_indexed(dividends.data(), indices.data(), quotients.data(), dividends.size());
+        for (size_t i = 0; i != dividends.size(); ++i) {
+            is_correct &= quotients[i] == Integer(dividends[i] / table.divisor(indices[i]));
+        }
+        // Reassigning a slot must replace all of its constants.
+        table.assign(0, Integer(1));
+        table.divide(dividends.data(), quotients.data(), 1);
+        is_correct &= quotients[0] == dividends[0] && table.divide(0, dividends[0]) == dividends[0];
+        return is_correct;
+    }
+
+}
+
+
+bool fd_t::divider_table_division()
+{
+    using fast_division::simd_level;
+    using fast_division::decomposition_policy;
+    bool is_correct = true;
+    for (auto level : { simd_level::scalar, simd_level::sse41, simd_level::avx2, simd_level::avx512 }) {
+        fast_division::force_simd_level(level);
+        is_correct &= table_division_impl<uint32_t>(1001, 100003);
+        is_correct &= table_division_impl<int32_t>(1001, 100003);
+        is_correct &= table_division_impl<uint32_t, decomposition_policy>(257, 10007);
+        is_correct &= table_division_impl<int32_t, decomposition_policy>(257, 10007);
+        is_correct &= table_division_impl<uint16_t>(257, 10007);
+        is_correct &= table_division_impl<int64_t>(257, 10007);
+    }
+    fast_division::reset_simd_level();
+    fast_division::divider_table<uint32_t> table{ 3, 1, 1u << 31 };
+    is_correct &= table.size() == 3 && table.divide(0, 100) == 33 && table.divide(1, 100) == 100 &&
+                  table.divide(2, 4294967295u) == 1 && table.divider(0)(9) == 3;
+    return is_correct;
+}
+
+
+namespace {
+
+    template<typename Integer, template <typename I, bool S> class Policy = fast_division::promotion_policy>
+    bool parallel_division_impl(fast_division::division_pool& pool, Integer divisor, std::size_t size,
+                                const fast_division::parallel_division_settings& settings)
+    {
+        using namespace std;
+        const constant_divider<Integer, Policy> divider(divisor);
+        mt19937_64 generator(size);
+        // One extra element so that the output can start off a cache line boundary.
+        vector<Integer> input(size + 1);
+        for (auto& n : input) {
+            n = static_cast<Integer>(generator());
+            if (divisor == Integer(-1) && n == numeric_limits<Integer>::min()) {
+                n = Integer(0);
+            }
+        }
+        vector<Integer> output(size + 1, Integer(0x5A));
+        bool is_correct = true;
+        for (size_t offset : { 0, 1 }) {
+            fast_division::parallel_divide(divider, input.data() + offset, output.data() + offset, size, pool, settings);
+            for (size_t i = 0; i != size; ++i) {
+                is_correct &= output[i + offset] == Integer(input[i + offset] / divisor);
+            }
+        }
+        // Both passes left output[i] = input[i] / divisor.
+        fast_division::parallel_divide_in_place(divider, input.data(), size, pool, settings);
+        for (size_t i = 0; i != size; ++i) {
+            is_correct &= input[i] == output[i];
+        }
+        return is_correct;
+    }
+
+}
+
+
+bool fd_t::parallel_division()
+{
+    fast_division::division_pool pool(4);
+    fast_division::division_pool single(1);
+    // Small chunks and no threshold give many chunks per thread and unaligned heads.
+    fast_division::parallel_division_settings fine;
+    fine.min_parallel_bytes = 0;
+    fine.chunk_bytes = 100;
+    fast_division::parallel_division_settings defaults;
+    bool is_correct = pool.concurrency() == 4 && single.concurrency() == 1;
+    for (std::size_t size : { 0, 1, 15, 16, 17, 1000, 100003 }) {
+        is_correct &= parallel_division_impl<uint32_t>(pool, 7u, size, fine);
+        is_correct &= parallel_division_impl<int32_t>(pool, -1, size, fine);
+        is_correct &= parallel_division_impl<uint8_t>(pool, uint8_t(3), size, fine);
+        is_correct &= parallel_division_impl<int64_t, fast_division::decomposition_policy>(pool, int64_t(-1000003), size, fine);
+        is_correct &= parallel_division_impl<uint16_t>(single, uint16_t(641), size, fine);
+    }
+    is_correct &= parallel_division_impl<uint32_t>(pool, 3u, 1 << 20, defaults);
+    is_correct &= parallel_division_impl<int16_t>(pool, int16_t(-9), 1 << 20, defaults);
+    // Loops started from several threads at once are serialized on the pool.
+    std::atomic<bool> threads_correct(true);
+    std::vector<std::thread> threads;
+    for (int t = 0; t != 4; ++t) {
+        threads.emplace_back([&pool, &fine, &threads_correct, t] {
+            for (int i = 0; i != 20; ++i) {
+                if (!parallel_division_impl<uint32_t>(pool, uint32_t(t + 3), 5000, fine)) {
+                    threads_correct = false;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    return is_correct && threads_correct;
+}
+
+
+namespace {
+
+    template<typename Integer>
+    std::vector<Integer> stream_dividends(std::size_t size)
+    {
+        std::mt19937_64 generator(size);
+        std::vector<Integer> dividends(size);
+        for (auto& n : dividends) {
+            n = static_cast<Integer>(generator());
+        }
+        return dividends;
+    }
+
+    /// Stream size values plus trailing_bytes extra bytes through temporary files.
+    template<typename Integer>
+    bool stream_division_impl(Integer divisor, std::size_t size, std::size_t trailing_bytes,
+                              const fast_division::stream_division_settings& settings)
+    {
+        using namespace std;
+        const constant_divider<Integer> divider(divisor);
+        auto dividends = stream_dividends<Integer>(size);
+        const char trailing[] = "tail";
+        FILE* input = tmpfile();
+        FILE* output = tmpfile();
+        if (input == nullptr || output == nullptr) {
+            for (FILE* file : { input, output }) {
+                if (file != nullptr) {
+                    fclose(file);
+                }
+            }
+            return false;
+        }
+        fwrite(dividends.data(), sizeof(Integer), size, input);
+        fwrite(trailing, 1, trailing_bytes, input);
+        rewind(input);
+        auto result = fast_division::divide_stream(divider, input, output, settings);
+        bool is_correct = result.elements == size && result.trailing_bytes == trailing_bytes &&
+                          !result.io_error && bool(result) == (trailing_bytes == 0);
+        rewind(output);
+        vector<Integer> quotients(size);
+        char tail[sizeof(trailing)] = {};
+        is_correct &= fread(quotients.data(), sizeof(Integer), size, output) == size;
+        is_correct &= fread(tail, 1, sizeof(tail), output) == trailing_bytes;
+        is_correct &= memcmp(tail, trailing, trailing_bytes) == 0;
+        for (size_t i = 0; i != size; ++i) {
+            is_correct &= quotients[i] == Integer(dividends[i] / divisor);
+        }
+        fclose(input);
+        fclose(output);
+        return is_correct;
+    }
+
+    template<typename Integer>
+    bool file_division_impl(Integer divisor, std::size_t size, const fast_division::stream_division_settings& settings)
+    {
+        using namespace std;
+        const char* path = "fast_division_stream_test.bin";
+        const char* quotient_path = "fast_division_stream_test.out";
+        const constant_divider<Integer> divider(divisor);
+        auto dividends = stream_dividends<Integer>(size);
+        FILE* file = fopen(path, "wb");
+        if (file == nullptr) {
+            return false;
+        }
+        fwrite(dividends.data(), sizeof(Integer), size, file);
+        fclose(file);
+        bool is_correct = bool(fast_division::divide_file(divider, path, quotient_path, settings));
+        is_correct &= bool(fast_division::divide_file_in_place(divider, path, settings));
+        vector<Integer> quotients(size + 1), in_place(size + 1);
+        for (auto read : { make_pair(quotient_path, &quotients), make_pair(path, &in_place) }) {
+            file = fopen(read.first, "rb");
+            is_correct &= file != nullptr;
+            if (file != nullptr) {
+                is_correct &= fread(read.second->data(), sizeof(Integer), size + 1, file) == size;
+                fclose(file);
+            }
+        }
+        for (size_t i = 0; i != size; ++i) {
+            is_correct &= quotients[i] == Integer(dividends[i] / divisor) && in_place[i] == quotients[i];
+        }
+        remove(path);
+        remove(quotient_path);
+        // A missing input is reported, not created.
+        is_correct &= fast_division::divide_file_in_place(divider, path, settings).io_error;
+        return is_correct;
+    }
+
+}
+
+
+bool fd_t::stream_division()
+{
+    fast_division::division_pool pool(3);
+    fast_division::stream_division_settings tiny;
+    tiny.block_bytes = 24;
+    fast_division::stream_division_settings pooled;
+    pooled.block_bytes = 1 << 16;
+    pooled.pool = &pool;
+    fast_division::stream_division_settings defaults;
+    bool is_correct = true;
+    for (std::size_t size : { 0, 1, 5, 6, 7, 1000 }) {
+        is_correct &= stream_division_impl<uint32_t>(7u, size, 0, tiny);
+        is_correct &= stream_division_impl<int64_t>(int64_t(-3), size, 5, tiny);
+        is_correct &= stream_division_impl<uint8_t>(uint8_t(10), size, 0, tiny);
+        is_correct &= stream_division_impl<int16_t>(int16_t(300), size, 1, defaults);
+    }
+    is_correct &= stream_division_impl<uint32_t>(1000u, 1000003, 3, defaults);
+    is_correct &= stream_division_impl<int32_t>(-17, 1000003, 0, pooled);
+    is_correct &= file_division_impl<uint32_t>(13u, 100003, tiny);
+    is_correct &= file_division_impl<int16_t>(int16_t(-5), 1000003, pooled);
+    return is_correct;
+}
+
+
+namespace {
+
+    template<typename Integer>
+    std::string reference_format(Integer value, unsigned base)
+    {
+        using u_type = std::make_unsigned_t<Integer>;
+        u_type magnitude = value < 0 ? u_type(u_type(0) - u_type(value)) : u_type(value);
+        std::string digits;
+        do {
+            unsigned digit = unsigned(magnitude % base);
+            digits.insert(digits.begin(), char(digit < 10 ? '0' + digit : 'a' + digit - 10));
+            magnitude = u_type(magnitude / base);
+        } while (magnitude != 0);
+        return value < 0 ? "-" + digits : digits;
+    }
+
+    template<typename Integer>
+    bool check_format(Integer value)
+    {
+        char buffer[fast_division::max_decimal_size<Integer>()];
+        char* end = fast_division::format_decimal(buffer, value);
+        return std::string(buffer, end) == std::to_string(value);
+    }
+
+    /// Random values of every length, the limits and the neighbours of every power of 10.
+    template<typename Integer>
+    bool format_decimal_impl(std::size_t num_values)
+    {
+        using namespace std;
+        bool is_correct = check_format(numeric_limits<Integer>::min()) && check_format(numeric_limits<Integer>::max());
+        for (Integer p = 1; p <= numeric_limits<Integer>::max() / 10; p = Integer(p * 10)) {
+            for (Integer n : { Integer(p - 1), p, Integer(p + 1), Integer(p * 10 - 1) }) {
+                is_correct &= check_format(n) && check_format(Integer(0 - n));
+            }
+        }
+        mt19937_64 generator(num_values);
+        uniform_int_distribution<int> shift_distribution(0, 8 * sizeof(Integer) - 1);
+        for (size_t i = 0; i != num_values; ++i) {
+            is_correct &= check_format(Integer(Integer(generator()) >> shift_distribution(generator)));
+        }
+        return is_correct;
+    }
+
+    template<typename Integer>
+    bool radix_format_impl(std::size_t num_values)
+    {
+        using namespace std;
+        bool is_correct = true;
+        mt19937_64 generator(num_values);
+        uniform_int_distribution<int> shift_distribution(0, 8 * sizeof(Integer) - 1);
+        for (unsigned base = 2; base <= 36; ++base) {
+            fast_division::radix_formatter<Integer> formatter(base);
+            char buffer[fast_division::radix_formatter<Integer>::max_size];
+            auto check = [&](Integer value) {
+                return string(buffer, formatter(buffer, value)) == reference_format(value, base);
+            };
+            is_correct &= formatter.base() == base && check(Integer(0)) &&
+                          check(numeric_limits<Integer>::min()) && check(numeric_limits<Integer>::max());
+            for (size_t i = 0; i != num_values; ++i) {
+                is_correct &= check(Integer(Integer(generator()) >> shift_distribution(generator)));
+            }
+        }
+        return is_correct;
+    }
+
+}
+
+
+bool fd_t::integer_formatting()
+{
+    using fast_division::simd_level;
+    bool is_correct = format_decimal_impl<uint32_t>(100000) && format_decimal_impl<int32_t>(100000) &&
+                      format_decimal_impl<uint64_t>(100000) && format_decimal_impl<int64_t>(100000) &&
+                      format_decimal_impl<uint16_t>(1000) && format_decimal_impl<int8_t>(1000) &&
+                      format_decimal_impl<unsigned long long>(1000) && format_decimal_impl<long>(1000);
+    is_correct &= radix_format_impl<uint8_t>(300) && radix_format_impl<int16_t>(300) &&
+                  radix_format_impl<uint32_t>(1000) && radix_format_impl<int64_t>(1000);
+    // Batches with a scalar tail, every length of value and the limits.
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> shift_distribution(0, 31);
+    std::vector<uint32_t> values = { 0, 9, 10, 99, 100, 4294967295u, 999999999, 1000000000, 42, 7 };
+    for (int i = 0; i != 10000; ++i) {
+        values.push_back(generator() >> shift_distribution(generator));
+    }
+    std::string expected;
+    for (auto n : values) {
+        expected += std::to_string(n) + ',';
+    }
+    std::vector<char> output(values.size() * (fast_division::max_decimal_size<uint32_t>() + 1));
+    for (auto level : { simd_level::scalar, simd_level::avx2 }) {
+        fast_division::force_simd_level(level);
+        for (std::size_t size : { std::size_t(0), std::size_t(3), std::size_t(8), values.size() }) {
+            char* end = fast_division::format_decimal(values.data(), size, output.data(), ',');
+            std::size_t length = 0;
+            for (std::size_t i = 0; i != size; ++i) {
+                length += std::to_string(values[i]).size() + 1;
+            }
+            is_correct &= std::string(output.data(), end) == expected.substr(0, length);
+        }
+    }
+    fast_division::reset_simd_level();
+    return is_correct;
+}
+
+
+namespace {
+
+    template<typename Buckets>
+    bool bucket_indices_impl(std::size_t num_hashes)
+    {
+        using namespace std;
+        using hash_type = typename Buckets::value_type;
+        bool is_correct = true;
+        mt19937_64 generator(num_hashes);
+        vector<hash_type> hashes(num_hashes);
+        for (auto& h : hashes) {
+            h = hash_type(generator());
+        }
+        hashes[0] = numeric_limits<hash_type>::max();
+        vector<hash_type> indices(num_hashes);
+        Buckets buckets;
+        for (size_t min_buckets : { size_t(0), size_t(5), size_t(100), size_t(1) << 20, size_t(3221225473u) }) {
+            size_t count = buckets.rehash(min_buckets);
+            is_correct &= count >= min_buckets && count == buckets.bucket_count();
+            buckets.indices(hashes.data(), indices.data(), num_hashes);
+            for (size_t i = 0; i != num_hashes; ++i) {
+                is_correct &= buckets.index(hashes[i]) == hashes[i] % count && indices[i] == hashes[i] % count;
+            }
+        }
+        return is_correct;
+    }
+
+    /// The same sequence of inserts, lookups and erases against std::unordered_map.
+    template<typename Buckets>
+    bool flat_hash_map_impl(std::size_t num_operations)
+    {
+        using namespace std;
+        bool is_correct = true;
+        fast_division::flat_hash_map<uint64_t, uint32_t, hash<uint64_t>, Buckets> map;
+        unordered_map<uint64_t, uint32_t> reference;
+        mt19937_64 generator(num_operations);
+        // Multiples of a large power of two, so that the keys differ in their high bits only.
+        uniform_int_distribution<uint64_t> key_distribution(0, 4 * num_operations);
+        auto key = [&] { return key_distribution(generator) << 20; };
+        for (size_t i = 0; i != num_operations; ++i) {
+            uint64_t k = key();
+            switch (generator() % 3) {
+            case 0:
+                is_correct &= map.insert(k, uint32_t(i)).second == reference.emplace(k, uint32_t(i)).second;
+                break;
+            case 1:
+                is_correct &= map.erase(k) == (reference.erase(k) != 0);
+                break;
+            default:
+                auto found = map.find(k);
+                auto expected = reference.find(k);
+                is_correct &= expected == reference.end() ? found == nullptr : found && *found == expected->second;
+            }
+        }
+        is_correct &= map.size() == reference.size();
+        map.for_each([&](uint64_t k, uint32_t v) {
+            auto expected = reference.find(k);
+            is_correct &= expected != reference.end() && expected->second == v;
+        });
+
+        vector<uint64_t> keys(1000);
+        for (auto& k : keys) {
+            k = key();
+        }
+        vector<uint32_t*> results(keys.size());
+        map.find(keys.data(), keys.size(), results.data());
+        for (size_t i = 0; i != keys.size(); ++i) {
+            is_correct &= results[i] == map.find(keys[i]);
+        }
+        map.clear();
+        is_correct &= map.empty() && map.find(keys[0]) == nullptr;
+        return is_correct;
+    }
+
+}
+
+
+bool fd_t::hash_bucket_indexing()
+{
+    using namespace std;
+    using fast_division::simd_level;
+    using fast_division::prime_buckets;
+    using fast_division::power_of_two_buckets;
+    bool is_correct = true;
+    for (auto level : { simd_level::scalar, simd_level::sse41, simd_level::avx2, simd_level::avx512 }) {
+        fast_division::force_simd_level(level);
+        is_correct &= bucket_indices_impl<prime_buckets<uint32_t>>(1001);
+        is_correct &= bucket_indices_impl<prime_buckets<uint32_t, fast_division::decomposition_policy>>(1001);
+    }
+    fast_division::reset_simd_level();
+    is_correct &= bucket_indices_impl<prime_buckets<uint64_t>>(1001);
+    is_correct &= bucket_indices_impl<power_of_two_buckets<uint32_t>>(1001);
+
+    is_correct &= flat_hash_map_impl<prime_buckets<uint32_t>>(100000);
+    is_correct &= flat_hash_map_impl<prime_buckets<uint64_t>>(10000);
+    is_correct &= flat_hash_map_impl<power_of_two_buckets<uint32_t>>(10000);
+
+    // Readers keep indexing while the bucket count changes under them.
+    prime_buckets<uint32_t> shared(100);
+    atomic<bool> done(false);
+    atomic<bool> threads_correct(true);
+    thread reader([&] {
+        uint32_t indices[64];
+        uint32_t hashes[64];
+        for (uint32_t i = 0; i != 64; ++i) {
+            hashes[i] = 2654435761u * i;
+        }
+        while (!done.load()) {
+            shared.indices(hashes, indices, 64);
+            for (auto i : indices) {
+                threads_correct = threads_correct && i < shared.max_bucket_count();
+            }
+        }
+    });
+    for (size_t n = 0; n != 10000; ++n) {
+        shared.rehash(n % 1000000);
+    }
+    done = true;
+    reader.join();
+    return is_correct && threads_correct;
+}
+
+
+namespace {
+
+    /// Divisors of every magnitude, the neighbours of every power of two and the limits.
+    template<typename Integer>
+    std::vector<Integer> batch_divisors(std::size_t num_random)
+    {
+        using namespace std;
+        vector<Integer> divisors;
+        for (unsigned s = 0; s != 8 * sizeof(Integer) - is_signed<Integer>::value; ++s) {
+            Integer p = Integer(Integer(1) << s);
+            for (Integer d : { p, Integer(p + 1), Integer(p - 1 == 0 ? 3 : p - 1) }) {
+                divisors.push_back(d);
+                if (is_signed<Integer>::value) {
+                    divisors.push_back(Integer(0 - d));
+                }
+            }
+        }
+        divisors.push_back(numeric_limits<Integer>::max());
+        divisors.push_back(numeric_limits<Integer>::min() == 0 ? Integer(1) : numeric_limits<Integer>::min());
+        mt19937_64 generator(num_random);
+        uniform_int_distribution<int> shift_distribution(0, 8 * sizeof(Integer) - 1);
+        while (divisors.size() < num_random) {
+            Integer d = Integer(Integer(generator()) >> shift_distribution(generator));
+            if (d != 0) {
+                divisors.push_back(d);
+            }
+        }
+        // A tail shorter than a vector.
+        divisors.push_back(Integer(7));
+        return divisors;
+    }
+
+    template<typename Integer, template <typename, bool> class DivisionPolicy = fast_division::promotion_policy>
+    bool batch_construction_impl(std::size_t num_random)
+    {
+        using namespace std;
+        auto divisors = batch_divisors<Integer>(num_random);
+        auto dividers = fast_division::make_dividers<DivisionPolicy>(divisors);
+        bool is_correct = dividers.size() == divisors.size() &&
+                          fast_division::make_dividers<DivisionPolicy>(divisors.data(), 0).empty();
+        mt19937_64 generator(42);
+        for (size_t i = 0; i != divisors.size(); ++i) {
+            const constant_divider<Integer, DivisionPolicy> expected(divisors[i]);
+            is_correct &= dividers[i] == expected;
+            for (Integer n : { numeric_limits<Integer>::max(), numeric_limits<Integer>::min(), Integer(generator()),
+                               Integer(generator()), Integer(0), Integer(divisors[i] / 2) }) {
+                is_correct &= dividers[i](n) == expected(n);
+            }
+        }
+        return is_correct;
+    }
+
+}
+
+
+bool fd_t::batch_construction()
+{
+    using fast_division::simd_level;
+    using fast_division::decomposition_policy;
+    bool is_correct = true;
+    for (auto level : { simd_level::scalar, simd_level::avx2 }) {
+        fast_division::force_simd_level(level);
+        is_correct &= batch_construction_impl<uint32_t>(100000);
+        is_correct &= batch_construction_impl<int32_t>(100000);
+        is_correct &= batch_construction_impl<uint32_t, decomposition_policy>(1000);
+        is_correct &= batch_construction_impl<int32_t, decomposition_policy>(1000);
+    }
+    fast_division::reset_simd_level();
+    is_correct &= batch_construction_impl<uint64_t>(10000);
+    is_correct &= batch_construction_impl<int64_t>(10000);
+    is_correct &= batch_construction_impl<int64_t, decomposition_policy>(1000);
+    is_correct &= batch_construction_impl<uint32_t, fast_division::fastmod_policy>(1000);
+    is_correct &= batch_construction_impl<int16_t>(1000);
+    return is_correct;
+}
+
+
+namespace {
+
+    template<typename Integer, template <typename, bool> class DivisionPolicy = fast_division::promotion_policy>
+    bool packed_division_impl(std::size_t num_random)
+    {
+        using namespace std;
+        using fast_division::packed_divider;
+        static_assert(sizeof(packed_divider<Integer, DivisionPolicy>) <= 2 * sizeof(Integer),
+                      "packed divider should take a word and a byte");
+        bool is_correct = true;
+        mt19937_64 generator(7);
+        for (Integer d : batch_divisors<Integer>(num_random)) {
+            const constant_divider<Integer, DivisionPolicy> expected(d);
+            const packed_divider<Integer, DivisionPolicy> packed(d);
+            is_correct &= packed == packed_divider<Integer, DivisionPolicy>(expected);
+            for (Integer n : { numeric_limits<Integer>::max(), numeric_limits<Integer>::min(), Integer(generator()),
+                               Integer(generator()), Integer(0), Integer(d / 2) }) {
+                is_correct &= packed(n) == expected(n) && n / packed == expected(n);
+                is_correct &= packed.remainder(n, d) == expected.remainder(n);
+            }
+        }
+        return is_correct;
+    }
+
+}
+
+
+bool fd_t::packed_division()
+{
+    using fast_division::decomposition_policy;
+    constexpr fast_division::packed_divider<uint32_t> seven(7);
+    static_assert(seven(100) == 14, "packed divider should be usable in constant expressions");
+    bool is_correct = true;
+    is_correct &= packed_division_impl<uint8_t>(1000);
+    is_correct &= packed_division_impl<int8_t>(1000);
+    is_correct &= packed_division_impl<uint16_t>(10000);
+    is_correct &= packed_division_impl<int16_t, decomposition_policy>(10000);
+    is_correct &= packed_division_impl<uint32_t>(100000);
+    is_correct &= packed_division_impl<int32_t>(100000);
+    is_correct &= packed_division_impl<uint32_t, decomposition_policy>(10000);
+    is_correct &= packed_division_impl<uint64_t>(100000);
+    is_correct &= packed_division_impl<int64_t>(100000);
+    is_correct &= packed_division_impl<int64_t, decomposition_policy>(10000);
+    return is_correct;
+}
+
+
+namespace {
+
+    /// Checks against the division of the promoted dividend, or half-word long division
+    /// where there is no wider type.
+    template<typename UInteger>
+    bool double_word_check(const fast_division::double_word_divider<UInteger>& divider, UInteger high, UInteger low)
+    {
+        UInteger remainder = 0;
+        const UInteger quotient = divider.divide(high, low, remainder);
+        UInteger expected_remainder = 0;
+        const UInteger expected = fast_division::utility::divide_double_word(high, low, divider.divisor(),
+                                                                             expected_remainder);
+        return quotient == expected && remainder == expected_remainder &&
+               divider(high, low) == expected && divider.remainder(high, low) == expected_remainder;
+    }
+
+    template<typename UInteger>
+    bool double_word_division_impl(std::size_t num_random)
+    {
+        using namespace std;
+        bool is_correct = true;
+        mt19937_64 generator(5);
+        for (UInteger d : batch_divisors<UInteger>(num_random)) {
+            const fast_division::double_word_divider<UInteger> divider(d);
+            is_correct &= double_word_check(divider, UInteger(d - 1), numeric_limits<UInteger>::max());
+            is_correct &= double_word_check(divider, UInteger(0), UInteger(0));
+            is_correct &= double_word_check(divider, UInteger(0), UInteger(d - 1));
+            is_correct &= double_word_check(divider, UInteger(d - 1), UInteger(0));
+            for (int i = 0; i != 4; ++i) {
+                is_correct &= double_word_check(divider, UInteger(UInteger(generator()) % d), UInteger(generator()));
+            }
+        }
+        return is_correct;
+    }
+
+}
+
+
+bool fd_t::double_word_division()
+{
+    using fast_division::double_word_divider;
+    static_assert(double_word_divider<uint32_t>(10)(3, 5) == uint32_t(((uint64_t(3) << 32) | 5) / 10),
+                  "double-word divider should be usable in constant expressions");
+    bool is_correct = true;
+    for (unsigned d = 1; d != 256; ++d) {
+        const double_word_divider<uint8_t> divider(static_cast<uint8_t>(d));
+        for (unsigned n = 0; n != d << 8; ++n) {
+            uint8_t remainder = 0;
+            is_correct &= divider.divide(uint8_t(n >> 8), uint8_t(n), remainder) == n / d && remainder == n % d;
+        }
+    }
+    is_correct &= double_word_division_impl<uint16_t>(10000);
+    is_correct &= double_word_division_impl<uint32_t>(100000);
+    is_correct &= double_word_division_impl<uint64_t>(100000);
+    return is_correct;
+}
+
+
+namespace {
+
+    /// Long division one limb at a time with half-word long division.
+    template<typename Limb>
+    Limb naive_divide_limbs(const std::vector<Limb>& number, Limb divisor, std::vector<Limb>& quotient)
+    {
+        quotient.assign(number.size(), 0);
+        Limb r = 0;
+        for (std::size_t i = number.size(); i != 0; --i) {
+            quotient[i - 1] = fast_division::utility::divide_double_word(r, number[i - 1], divisor, r);
+        }
+        return r;
+    }
+
+    template<typename Limb>
+    bool limb_division_impl(std::size_t num_random)
+    {
+        using namespace std;
+        bool is_correct = true;
+        mt19937_64 generator(9);
+        vector<vector<Limb>> numbers;
+        for (size_t size : { 0, 1, 2, 3, 17, 64 }) {
+            numbers.emplace_back(size);
+            for (auto& limb : numbers.back()) {
+                limb = Limb(generator());
+            }
+            numbers.emplace_back(size, numeric_limits<Limb>::max());
+        }
+        vector<const Limb*> pointers;
+        vector<size_t> sizes;
+        for (auto& number : numbers) {
+            pointers.push_back(number.data());
+            sizes.push_back(number.size());
+        }
+        for (Limb d : batch_divisors<Limb>(num_random)) {
+            const fast_division::double_word_divider<Limb> divider(d);
+            vector<Limb> expected_quotient;
+            vector<Limb> expected_remainders;
+            for (auto& number : numbers) {
+                expected_remainders.push_back(naive_divide_limbs(number, d, expected_quotient));
+                vector<Limb> quotient(number.size());
+                is_correct &= fast_division::divide_limbs(number.data(), number.size(), divider, quotient.data())
+                                  == expected_remainders.back();
+                is_correct &= quotient == expected_quotient;
+                is_correct &= fast_division::remainder_limbs(number.data(), number.size(), divider)
+                                  == expected_remainders.back();
+                // In place.
+                quotient = number;
+                fast_division::divide_limbs(quotient.data(), quotient.size(), divider, quotient.data());
+                is_correct &= quotient == expected_quotient;
+            }
+            // All counts from 0 up, so that both the lockstep groups and the tail are covered.
+            for (size_t count = 0; count <= numbers.size(); ++count) {
+                vector<Limb> remainders(count);
+                fast_division::remainder_limbs(pointers.data(), sizes.data(), count, divider, remainders.data());
+                is_correct &= equal(remainders.begin(), remainders.end(), expected_remainders.begin());
+            }
+        }
+        return is_correct;
+    }
+
+}
+
+
+bool fd_t::limb_division()
+{
+    bool is_correct = true;
+    is_correct &= limb_division_impl<uint8_t>(100);
+    is_correct &= limb_division_impl<uint16_t>(100);
+    is_correct &= limb_division_impl<uint32_t>(1000);
+    is_correct &= limb_division_impl<uint64_t>(1000);
+    return is_correct;
+}
+
+
+namespace {
+
+    /// Reference modular arithmetic by half-word long division of the double-word result.
+    template<typename UInteger>
+    UInteger reference_mulmod(UInteger a, UInteger b, UInteger m)
+    {
+        UInteger r = 0;
+        fast_division::utility::divide_double_word(UInteger(fast_division::utility::high_mult(a, b) % m),
+                                                   fast_division::utility::low_mult(a, b), m, r);
+        return r;
+    }
+
+    template<typename UInteger>
+    UInteger reference_addmod(UInteger a, UInteger b, UInteger m)
+    {
+        const UInteger sum = UInteger(a + b);
+        UInteger r = 0;
+        fast_division::utility::divide_double_word(UInteger(sum < a ? 1 % m : 0), sum, m, r);
+        return r;
+    }
+
+    template<typename UInteger>
+    UInteger reference_powmod(UInteger base, uint64_t exponent, UInteger m)
+    {
+        UInteger result = UInteger(1 % m);
+        for (; exponent != 0; exponent >>= 1) {
+            if (exponent & 1) {
+                result = reference_mulmod(result, base, m);
+            }
+            base = reference_mulmod(base, base, m);
+        }
+        return result;
+    }
+
+    template<typename UInteger>
+    bool modular_arithmetic_impl(std::size_t num_random)
+    {
+        using namespace std;
+        bool is_correct = true;
+        mt19937_64 generator(13);
+        for (UInteger m : batch_divisors<UInteger>(num_random)) {
+            const fast_division::barrett_modulus<UInteger> barrett(m);
+            for (int i = 0; i != 8; ++i) {
+                const UInteger x = UInteger(UInteger(generator()) % m);
+                const UInteger y = UInteger(UInteger(generator()) % m);
+                const UInteger z = UInteger(generator());
+                const uint64_t e = generator() >> (generator() % 64);
+                is_correct &= barrett.reduce(z) == UInteger(z % m);
+                is_correct &= barrett.mulmod(x, z) == reference_mulmod(x, z, m);
+                is_correct &= barrett.addmod(x, y) == reference_addmod(x, y, m);
+                is_correct &= reference_addmod(barrett.submod(x, y), y, m) == x;
+                is_correct &= barrett.powmod(z, e) == reference_powmod(UInteger(z % m), e, m);
+            }
+            if ((m & 1) == 0) {
+                continue;
+            }
+            const fast_division::montgomery_modulus<UInteger> montgomery(m);
+            is_correct &= montgomery.from_montgomery(montgomery.one()) == UInteger(1 % m);
+            for (int i = 0; i != 8; ++i) {
+                const UInteger x = UInteger(UInteger(generator()) % m);
+                const UInteger y = UInteger(UInteger(generator()) % m);
+                const UInteger z = UInteger(generator());
+                const uint64_t e = generator() >> (generator() % 64);
+                const UInteger x_form = montgomery.to_montgomery(x);
+                const UInteger y_form = montgomery.to_montgomery(y);
+                is_correct &= x_form < m && montgomery.from_montgomery(x_form) == x;
+                is_correct &= montgomery.to_montgomery(z) == montgomery.to_montgomery(UInteger(z % m));
+                is_correct &= montgomery.from_montgomery(montgomery.mulmod(x_form, y_form)) == reference_mulmod(x, y, m);
+                is_correct &= montgomery.from_montgomery(montgomery.addmod(x_form, y_form)) == reference_addmod(x, y, m);
+                is_correct &= montgomery.addmod(montgomery.submod(x_form, y_form), y_form) == x_form;
+                is_correct &= montgomery.from_montgomery(montgomery.powmod(montgomery.to_montgomery(z), e))
+                                  == reference_powmod(UInteger(z % m), e, m);
+            }
+        }
+        return is_correct;
+    }
+
+    bool modular_arrays_impl()
+    {
+        using namespace std;
+        bool is_correct = true;
+        mt19937_64 generator(17);
+        for (uint32_t m : batch_divisors<uint32_t>(1000)) {
+            // All lengths below two AVX2 vectors, so that the scalar tails are covered.
+            const size_t size = generator() % 17;
+            vector<uint32_t> a(size), b(size), output(size);
+            for (size_t i = 0; i != size; ++i) {
+                a[i] = uint32_t(generator()) % m;
+                b[i] = uint32_t(generator());
+            }
+            const fast_division::barrett_modulus<uint32_t> barrett(m);
+            barrett.mulmod(a.data(), b.data(), output.data(), size);
+            for (size_t i = 0; i != size; ++i) {
+                is_correct &= output[i] == barrett.mulmod(a[i], b[i]);
+            }
+            if ((m & 1) == 0) {
+                continue;
+            }
+            const fast_division::montgomery_modulus<uint32_t> montgomery(m);
+            for (size_t i = 0; i != size; ++i) {
+                b[i] %= m;
+            }
+            montgomery.mulmod(a.data(), b.data(), output.data(), size);
+            for (size_t i = 0; i != size; ++i) {
+                is_correct &= output[i] == montgomery.mulmod(a[i], b[i]);
+            }
+        }
+        return is_correct;
+    }
+
+}
+
+
+bool fd_t::modular_arithmetic()
+{
+    using fast_division::simd_level;
+    static_assert(fast_division::barrett_modulus<uint32_t>(7).mulmod(5, 6) == 2,
+                  "Barrett modulus should be usable in constant expressions");
+    bool is_correct = true;
+    is_correct &= modular_arithmetic_impl<uint8_t>(1000);
+    is_correct &= modular_arithmetic_impl<uint16_t>(1000);
+    is_correct &= modular_arithmetic_impl<uint32_t>(10000);
+    is_correct &= modular_arithmetic_impl<uint64_t>(10000);
+    for (auto level : { simd_level::scalar, simd_level::sse41, simd_level::avx2 }) {
+        if (fast_division::force_simd_level(level) == level) {
+            is_correct &= modular_arrays_impl();
+        }
+    }
+    fast_division::reset_simd_level();
+    return is_correct;
+}
+
+
+namespace {
+
+    /// Decomposes random indices by three radices drawn from batch_divisors, in both forms, and
+    /// checks the digits against chained / and % and the round trip through compose.
+    template<typename Integer, template <typename, bool> class DivisionPolicy = fast_division::promotion_policy>
+    bool mixed_radix_impl(std::size_t num_random)
+    {
+        using namespace std;
+        using mixed_radix = fast_division::mixed_radix<Integer, 3, DivisionPolicy>;
+        bool is_correct = true;
+        mt19937_64 generator(19);
+        // Radices are positive, as extents are; -1 would overflow on the minimum like the built-in /.
+        vector<Integer> radices;
+        for (Integer d : batch_divisors<Integer>(num_random)) {
+            if (d > 0) {
+                radices.push_back(d);
+            }
+        }
+        for (size_t j = 0; j != radices.size(); ++j) {
+            const array<Integer, 3> r = { radices[j],
+                                          radices[generator() % radices.size()],
+                                          radices[generator() % radices.size()] };
+            const mixed_radix system(r);
+            // Lengths below two AVX-512 vectors of bytes, so that the scalar tails are covered.
+            const size_t size = generator() % 129;
+            vector<Integer> indices(size), composed(size);
+            array<vector<Integer>, 4> digits;
+            for (auto& digit : digits) {
+                digit.resize(size);
+            }
+            for (size_t i = 0; i != size; ++i) {
+                indices[i] = Integer(generator());
+            }
+            const array<Integer*, 4> digit_pointers = { digits[0].data(), digits[1].data(),
+                                                        digits[2].data(), digits[3].data() };
+            system.decompose(indices.data(), size, digit_pointers.data());
+            for (size_t i = 0; i != size; ++i) {
+                Integer n = indices[i];
+                const auto expected = system.decompose(n);
+                for (size_t k = 0; k != 3; ++k) {
+                    is_correct &= expected[k] == Integer(n % r[k]);
+                    is_correct &= digits[k][i] == expected[k];
+                    n = Integer(n / r[k]);
+                }
+                is_correct &= expected[3] == n && digits[3][i] == n;
+                is_correct &= system.compose(expected) == indices[i];
+            }
+            const array<const Integer*, 4> const_pointers = { digits[0].data(), digits[1].data(),
+                                                              digits[2].data(), digits[3].data() };
+            system.compose(const_pointers.data(), size, composed.data());
+            is_correct &= composed == indices;
+        }
+        return is_correct;
+    }
+
+}
+
+
+bool fd_t::mixed_radix_decomposition()
+{
+    using fast_division::simd_level;
+    constexpr fast_division::mixed_radix<uint32_t, 3> duration(std::array<uint32_t, 3>{ { 60, 60, 24 } });
+    static_assert(duration.decompose(93784)[3] == 1 && duration.decompose(93784)[1] == 3
+                      && duration.compose({ { 4, 3, 2, 1 } }) == 93784,
+                  "Mixed radix decomposition should be usable in constant expressions");
+    bool is_correct = true;
+    for (auto level : { simd_level::scalar, simd_level::sse41, simd_level::avx2, simd_level::avx512 }) {
+        if (fast_division::force_simd_level(level) == level) {
+            is_correct &= mixed_radix_impl<uint8_t>(1000);
+            is_correct &= mixed_radix_impl<int8_t>(1000);
+            is_correct &= mixed_radix_impl<uint16_t>(1000);
+            is_correct &= mixed_radix_impl<int16_t>(1000);
+            is_correct &= mixed_radix_impl<uint32_t>(1000);
+            is_correct &= mixed_radix_impl<int32_t>(1000);
+            is_correct &= mixed_radix_impl<uint32_t, fast_division::decomposition_policy>(1000);
+            is_correct &= mixed_radix_impl<uint64_t>(1000);
+        }
+    }
+    fast_division::reset_simd_level();
+    return is_correct;
+}
+
+
+namespace {
+
+    template<typename Base>
+    Base rebuild_from_constants(const Base& constants, std::false_type)
+    {
+        return Base(fast_division::precomputed, constants.multiplier(), constants.add_shift(), constants.post_shift());
+    }
+
+    template<typename Base>
+    Base rebuild_from_constants(const Base& constants, std::true_type)
+    {
+        using Integer = std::decay_t<decltype(constants.multiplier())>;
+        return Base(fast_division::precomputed, constants.multiplier(), constants.post_shift(),
+                    Integer(constants.negative() ? -1 : 0));
+    }
+
+    /// The class of every divisor from batch_divisors against its definition, and a divider
+    /// rebuilt from the reported constants against the original.
+    template<typename Integer>
+    bool introspection_impl(std::size_t num_random)
+    {
+        using namespace std;
+        using fast_division::divider_algorithm;
+        using u_type = make_unsigned_t<Integer>;
+        bool is_correct = true;
+        mt19937_64 generator(23);
+        for (Integer d : batch_divisors<Integer>(num_random)) {
+            const fast_division::constant_divider<Integer> divider(d);
+            const u_type magnitude = d < 0 ? u_type(u_type(0) - u_type(d)) : u_type(d);
+            const auto expected = magnitude == 1 ? divider_algorithm::identity :
+                                  u_type(magnitude & u_type(magnitude - 1)) == 0 ? divider_algorithm::power_of_two :
+                                  divider_algorithm::multiply;
+            is_correct &= divider.algorithm() == expected;
+            const auto& constants = divider.constants();
+            if (is_signed<Integer>::value) {
+                is_correct &= constants.add_step();
+            }
+            else {
+                is_correct &= constants.add_step() == (expected == divider_algorithm::multiply);
+                is_correct &= (constants.multiplier() == 0) == (expected != divider_algorithm::multiply);
+            }
+            const auto rebuilt = rebuild_from_constants(constants, is_signed<Integer>());
+            for (int i = 0; i != 16; ++i) {
+                const Integer n = Integer(generator());
+                is_correct &= rebuilt(n) == divider(n);
+            }
+        }
+        return is_correct;
+    }
+
+    /// Divisions of each kind from this thread and another one, against the counts expected.
+    bool statistics_impl()
+    {
+        using namespace std;
+        using fast_division::divider_algorithm;
+        using fast_division::simd_level;
+        const fast_division::constant_divider<uint32_t> by_one(1), by_eight(8), by_seven(7);
+        const fast_division::constant_divider<int16_t> by_minus_three(-3);
+        vector<uint32_t> values(100, 12345);
+        fast_division::reset_statistics();
+        uint32_t sum = 0;
+        for (uint32_t i = 0; i != 10; ++i) {
+            sum += i / by_eight + by_seven.remainder(i) + by_seven.divmod(i).quotient;
+        }
+        sum += uint32_t(by_minus_three(int16_t(sum)));
+        __m256i q = by_seven.divmod(_mm256_set1_epi32(int(sum))).quotient;
+        __m128i r = by_seven.remainder(_mm_set1_epi32(int(sum)));
+        sum += uint32_t(_mm256_extract_epi32(q, 0)) + uint32_t(_mm_extract_epi32(r, 0));
+        const simd_level level = fast_division::force_simd_level(simd_level::avx2);
+        by_one.divide_in_place(values.data(), values.size());
+        // One division per radix of every index and one per hash, counted as the arrays dispatch.
+        const fast_division::mixed_radix<uint32_t, 2> grid(array<uint32_t, 2>{ { 640, 480 } });
+        vector<uint32_t> x(20), y(20), z(20);
+        uint32_t* digits[] = { x.data(), y.data(), z.data() };
+        grid.decompose(values.data(), 20, digits);
+        const fast_division::prime_buckets<uint32_t> buckets(100);
+        buckets.indices(values.data(), x.data(), 10);
+        fast_division::reset_simd_level();
+        thread([&] { values[0] = values[1] / by_eight; }).join();
+        const auto statistics = fast_division::statistics_snapshot();
+
+        if (!fast_division::statistics_enabled) {
+            return statistics.total() == 0 && sum != 0;
+        }
+        bool is_correct = true;
+        is_correct &= statistics.count(divider_algorithm::power_of_two, simd_level::scalar) == 11;
+        // The arrays count under the level they ran at, which lacks AVX2 on older processors.
+        const simd_level levels[] = { simd_level::scalar, simd_level::sse41, simd_level::avx2, simd_level::avx512 };
+        uint64_t multiply[] = { 21, 4, 8, 0 };
+        multiply[static_cast<int>(level)] += 50;
+        for (int l = 0; l != 4; ++l) {
+            is_correct &= statistics.count(divider_algorithm::multiply, levels[l]) == multiply[l];
+        }
+        is_correct &= statistics.count(divider_algorithm::identity, level) == 100;
+        is_correct &= statistics.count(divider_algorithm::identity) == 100;
+        is_correct &= statistics.total() == 194;
+        fast_division::reset_statistics();
+        is_correct &= fast_division::statistics_snapshot().total() == 0;
+        return is_correct;
+    }
+
+}
+
+
+bool fd_t::divider_introspection()
+{
+    using fast_division::divider_algorithm;
+    constexpr fast_division::constant_divider<uint32_t> by_seven(7);
+    static_assert(by_seven.algorithm() == divider_algorithm::multiply && by_seven.constants().add_step()
+                      && by_seven(700) == 100,
+                  "Divider introspection should be usable in constant expressions");
+    static_assert(fast_division::constant_divider<uint64_t>(1024).constants().post_shift() == 10,
+                  "A power of two should only shift");
+    bool is_correct = true;
+    is_correct &= introspection_impl<uint8_t>(1000);
+    is_correct &= introspection_impl<int8_t>(1000);
+    is_correct &= introspection_impl<uint16_t>(1000);
+    is_correct &= introspection_impl<int16_t>(1000);
+    is_correct &= introspection_impl<uint32_t>(1000);
+    is_correct &= introspection_impl<int32_t>(1000);
+    is_correct &= introspection_impl<uint64_t>(1000);
+    is_correct &= introspection_impl<int64_t>(1000);
+    is_correct &= statistics_impl();
+    return is_correct;
+}
@@ -12,12 +12,58 @@ namespace fast_division {
 
         bool division_random_simd(uint32_t num_divisions, uint32_t divisions_per_divisor);
 
+        bool division_random_simd_avx(uint32_t num_divisions, uint32_t divisions_per_divisor);
+
+        bool division_random_signed_simd(uint32_t num_divisions, uint32_t divisions_per_divisor);
+
         bool random_unsigned_division();
 
         bool random_signed_division();
 
+        bool random_decomposition_division();
+
+        bool random_fastmod_division();
+
         bool high_multiplication();
 
+        bool dispatched_division();
+
+        bool static_division();
+
+        bool exact_division();
+
+        bool cached_division();
+
+        bool branchfree_division();
+
+        bool rounded_division();
+
+        bool division_narrow_simd();
+
+        bool divider_table_division();
+
+        bool parallel_division();
+
+        bool stream_division();
+
+        bool integer_formatting();
+
+        bool hash_bucket_indexing();
+
+        bool batch_construction();
+
+        bool packed_division();
+
+        bool double_word_division();
+
+        bool limb_division();
+
+        bool modular_arithmetic();
+
+        bool mixed_radix_decomposition();
+
+        bool divider_introspection();
+
     }
 
 }
@@ -10,10 +10,40 @@ int main()
     auto high_mult_test = fd_t::high_multiplication();
     auto unsigned_test = fd_t::random_unsigned_division();
     auto signed_test = fd_t::random_signed_division();
-    //auto simd_test = fd_t::division_simd(0, 10000, 1, 101);
-    //auto simd_primes_test = fd_t::division_by_primes_simd(0, 100000, 0, 200);
-    //auto random_simd_test = fd_t::division_random_simd(1000, 100000);
+    auto decomposition_test = fd_t::random_decomposition_division();
+    auto fastmod_test = fd_t::random_fastmod_division();
+    auto simd_test = fd_t::division_simd(0, 10000, 1, 101);
+    auto simd_primes_test = fd_t::division_by_primes_simd(0, 100000, 0, 200);
+    auto random_simd_test = fd_t::division_random_simd(1000, 100000);
+    auto random_simd_avx_test = fd_t::division_random_simd_avx(1000, 10000);
+    auto random_signed_simd_test = fd_t::division_random_signed_simd(1000, 10000);
+    auto dispatch_test = fd_t::dispatched_division();
+    auto static_test = fd_t::static_division();
+    auto exact_test = fd_t::exact_division();
+    auto cache_test = fd_t::cached_division();
+    auto branchfree_test = fd_t::branchfree_division();
+    auto rounded_test = fd_t::rounded_division();
+    auto narrow_simd_test = fd_t::division_narrow_simd();
+    auto table_test = fd_t::divider_table_division();
+    auto parallel_test = fd_t::parallel_division();
+    auto stream_test = fd_t::stream_division();
+    auto format_test = fd_t::integer_formatting();
+    auto hash_test = fd_t::hash_bucket_indexing();
+    auto batch_test = fd_t::batch_construction();
+    auto packed_test = fd_t::packed_division();
+    auto double_word_test = fd_t::double_word_division();
+    auto limb_test = fd_t::limb_division();
+    auto modular_test = fd_t::modular_arithmetic();
+    auto mixed_radix_test = fd_t::mixed_radix_decomposition();
+    auto introspection_test = fd_t::divider_introspection();
 
-    return !(high_mult_test && unsigned_test && signed_test
-             /*&& simd_test && simd_primes_test && random_simd_test*/);
+    return !(high_mult_test && unsigned_test && signed_test && decomposition_test && fastmod_test
+             && simd_test && simd_primes_test && random_simd_test
+             && random_simd_avx_test && random_signed_simd_test && dispatch_test
+             && static_test && exact_test && cache_test && branchfree_test
+             && rounded_test && narrow_simd_test && table_test
+             && parallel_test && stream_test && format_test
+             && hash_test && batch_test && packed_test
+             && double_word_test && limb_test && modular_test
+             && mixed_radix_test && introspection_test);
 }